@@ -0,0 +1,158 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENSCENARIO_INTERPRETER__CONTEXT_PUBLISHER_HPP_
+#define OPENSCENARIO_INTERPRETER__CONTEXT_PUBLISHER_HPP_
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <nlohmann/json.hpp>
+#include <openscenario_interpreter/syntax/open_scenario.hpp>
+#include <openscenario_interpreter/syntax/storyboard_element.hpp>
+#include <openscenario_interpreter/syntax/trigger.hpp>
+#include <openscenario_interpreter_msgs/msg/context.hpp>
+#include <optional>
+#include <rclcpp/time.hpp>
+#include <rclcpp_lifecycle/lifecycle_publisher.hpp>
+#include <string>
+#include <thread>
+#include <typeinfo>
+#include <utility>
+#include <variant>
+#include <vector>
+
+namespace openscenario_interpreter
+{
+/* ---- ContextPublisher -------------------------------------------------------
+ *
+ *  Publishes the context (the JSON written by `json << OpenScenario`) without
+ *  building or serializing any JSON on the thread evaluating the scenario.
+ *
+ *  The structure of the scenario is walked only once on construction. After
+ *  that, `publish` only copies the values that can change while a scenario is
+ *  running (the state of each StoryboardElement, the value of each Trigger,
+ *  ConditionGroup and Condition, and so on) into a snapshot and hands it over
+ *  to a dedicated thread, which updates its own copy of the context and
+ *  serializes and publishes it.
+ *
+ *  If a publisher for deltas is given, the full context is published only
+ *  once on construction. Thereafter, the changes since the previous
+ *  publication are published as a JSON Patch (RFC 6902) against the full
+ *  context, so that the subscriber can keep its copy up to date with
+ *  `nlohmann::json::patch`. In this mode, `currentEvaluation` of a Condition
+ *  (the description string) is reported only together with a change in its
+ *  `currentValue`, since the description of most conditions changes every
+ *  frame.
+ *
+ *  The full context is published again instead of a delta when a new
+ *  subscriber of deltas is found, since it has missed the deltas published
+ *  before it joined, and when the thread publishing falls behind by more than
+ *  `max_snapshots` snapshots, which are then coalesced into one so that the
+ *  memory they take is bounded. A subscriber is expected to discard the
+ *  deltas up to the `frame` of the latest full context it has received.
+ *
+ * -------------------------------------------------------------------------- */
+class ContextPublisher
+{
+public:
+  using Context = openscenario_interpreter_msgs::msg::Context;
+
+  using Publisher = rclcpp_lifecycle::LifecyclePublisher<Context>;
+
+private:
+  struct ConditionValue
+  {
+    bool value;
+
+    std::optional<std::string> description;
+
+    auto operator==(const ConditionValue & rhs) const { return value == rhs.value; }
+
+    auto operator!=(const ConditionValue & rhs) const { return value != rhs.value; }
+  };
+
+  // NOTE: Each StoryboardElementState is a shared instance, so its address is enough.
+  using Value = std::variant<const Expression *, bool, long, ConditionValue>;
+
+  struct Snapshot
+  {
+    rclcpp::Time stamp;
+
+    double time;
+
+    std::size_t frame;
+
+    std::vector<Value> values;
+
+    bool is_full;  // NOTE: Whether the description of each Condition is taken.
+  };
+
+  struct Probe
+  {
+    nlohmann::json::json_pointer pointer;
+
+    std::function<Value()> get;
+  };
+
+  const std::shared_ptr<Publisher> publisher_of_context;
+
+  const std::shared_ptr<Publisher> publisher_of_context_delta;
+
+  const OpenScenario & script;
+
+  std::vector<Probe> probes;
+
+  nlohmann::json context;  // NOTE: Owned by the worker thread after construction.
+
+  std::vector<Value> previous_values;  // NOTE: Owned by the worker thread after construction.
+
+  static constexpr std::size_t max_snapshots = 100;
+
+  std::deque<Snapshot> snapshots;
+
+  std::mutex snapshots_mutex;
+
+  std::condition_variable snapshots_condition;
+
+  bool is_stop_requested = false;
+
+  bool is_full_snapshot_taken = false;  // NOTE: Owned by the thread calling `publish`.
+
+  std::thread worker;
+
+public:
+  explicit ContextPublisher(
+    const OpenScenario &, const std::shared_ptr<Publisher> &,
+    const std::shared_ptr<Publisher> & = nullptr);
+
+  ~ContextPublisher();
+
+  auto publish(const rclcpp::Time &, double) -> void;
+
+private:
+  auto probe(const std::string &, std::function<Value()> &&) -> void;
+
+  auto probe(const std::string &, const Trigger &) -> void;
+
+  auto probe(const std::string &, const StoryboardElement &, const std::type_info &) -> void;
+
+  static auto makeContext(const Snapshot &, const nlohmann::json &) -> Context;
+
+  auto write(const Snapshot &) -> nlohmann::json;
+};
+}  // namespace openscenario_interpreter
+
+#endif  // OPENSCENARIO_INTERPRETER__CONTEXT_PUBLISHER_HPP_
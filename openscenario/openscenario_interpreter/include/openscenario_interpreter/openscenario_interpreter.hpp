@@ -21,6 +21,7 @@
 #include <lifecycle_msgs/msg/transition.hpp>
 #include <memory>
 #include <openscenario_interpreter/console/escape_sequence.hpp>
+#include <openscenario_interpreter/context_publisher.hpp>
 #include <openscenario_interpreter/simulator_core.hpp>
 #include <openscenario_interpreter/syntax/custom_command_action.hpp>
 #include <openscenario_interpreter/syntax/open_scenario.hpp>
@@ -52,6 +53,14 @@ class Interpreter : public rclcpp_lifecycle::LifecycleNode,
 
   const rclcpp_lifecycle::LifecyclePublisher<Context>::SharedPtr publisher_of_context;
 
+  const rclcpp_lifecycle::LifecyclePublisher<Context>::SharedPtr publisher_of_context_delta;
+
+  bool as_fast_as_possible;
+
+  bool batch_mode;
+
+  double context_publish_rate;
+
   double local_frame_rate;
 
   double local_real_time_factor;
@@ -60,6 +69,8 @@ class Interpreter : public rclcpp_lifecycle::LifecycleNode,
 
   String output_directory;
 
+  bool publish_context_delta;
+
   bool record;
 
   std::shared_ptr<OpenScenario> script;
@@ -68,6 +79,10 @@ class Interpreter : public rclcpp_lifecycle::LifecycleNode,
 
   std::shared_ptr<rclcpp::TimerBase> timer;
 
+  std::shared_ptr<rclcpp::TimerBase> timer_of_context;
+
+  std::unique_ptr<ContextPublisher> context_publisher;
+
   common::JUnit5 results;
 
   boost::variant<common::junit::Pass, common::junit::Failure, common::junit::Error> result;
@@ -84,6 +99,8 @@ public:
 
   ~Interpreter() override;
 
+  auto currentContextPublishRate() const -> std::chrono::milliseconds;
+
   auto currentLocalFrameRate() const -> std::chrono::milliseconds;
 
   auto currentScenarioDefinition() const -> const std::shared_ptr<ScenarioDefinition> &;
@@ -108,6 +125,8 @@ public:
 
   auto on_shutdown(const rclcpp_lifecycle::State &) -> Result override;
 
+  auto publishContext() -> void;
+
   auto publishCurrentContext() const -> void;
 
   auto reset() -> void;
@@ -195,7 +214,8 @@ public:
   template <typename TimeoutHandler, typename Thunk>
   auto withTimeoutHandler(TimeoutHandler && handle, Thunk && thunk) -> decltype(auto)
   {
-    if (const auto time = execution_timer.invoke("", thunk); currentLocalFrameRate() < time) {
+    if (const auto time = execution_timer.invoke("", thunk);
+        not as_fast_as_possible and currentLocalFrameRate() < time) {
       handle(execution_timer.getStatistics(""));
     }
   }
@@ -0,0 +1,61 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENSCENARIO_INTERPRETER__PARAMETER_STORE_HPP_
+#define OPENSCENARIO_INTERPRETER__PARAMETER_STORE_HPP_
+
+#include <memory>
+#include <mutex>
+#include <rclcpp/node_interfaces/node_parameters_interface.hpp>
+#include <rclcpp/parameter_value.hpp>
+#include <string>
+#include <unordered_map>
+
+namespace openscenario_interpreter
+{
+/* ---- ParameterStore ---------------------------------------------------------
+ *
+ *  Process-wide store of the ROS 2 parameters given to the simulation (e.g.
+ *  "consider_pose_by_road_slope") for the syntax elements of the scenario.
+ *
+ *  Each parameter is read from the source node only once, and the value is
+ *  cached until the source is replaced by `use`. If no source is given (e.g.
+ *  the scenario is loaded without the Interpreter), a single node
+ *  "/simulation/get_parameter" is created on demand and used as the source.
+ *
+ * -------------------------------------------------------------------------- */
+class ParameterStore
+{
+  using Source = rclcpp::node_interfaces::NodeParametersInterface;
+
+  static inline std::shared_ptr<Source> source = nullptr;
+
+  static inline std::unordered_map<std::string, rclcpp::ParameterValue> values;
+
+  static inline std::mutex mutex;
+
+  static auto get(const std::string &, const rclcpp::ParameterValue &) -> rclcpp::ParameterValue;
+
+public:
+  static auto use(const std::shared_ptr<Source> &) -> void;
+
+  template <typename T>
+  static auto get(const std::string & name, const T & default_value) -> T
+  {
+    return get(name, rclcpp::ParameterValue(default_value)).get<T>();
+  }
+};
+}  // namespace openscenario_interpreter
+
+#endif  // OPENSCENARIO_INTERPRETER__PARAMETER_STORE_HPP_
@@ -15,33 +15,123 @@
 #ifndef OPENSCENARIO_INTERPRETER__READER__ATTRIBUTE_HPP_
 #define OPENSCENARIO_INTERPRETER__READER__ATTRIBUTE_HPP_
 
+#include <algorithm>
+#include <ament_index_cpp/get_package_prefix.hpp>
 #include <ament_index_cpp/get_package_share_directory.hpp>
+#include <boost/algorithm/string/classification.hpp>
 #include <boost/algorithm/string/replace.hpp>
+#include <boost/algorithm/string/split.hpp>
+#include <charconv>
+#include <cmath>
 #include <concealer/execute.hpp>
 #include <functional>
 #include <openscenario_interpreter/reader/evaluate.hpp>
+#include <openscenario_interpreter/syntax/double.hpp>
+#include <openscenario_interpreter/syntax/integer.hpp>
 #include <openscenario_interpreter/syntax/parameter_type.hpp>
+#include <openscenario_interpreter/syntax/unsigned_integer.hpp>
+#include <openscenario_interpreter/syntax/unsigned_short.hpp>
 #include <openscenario_interpreter/utility/highlighter.hpp>
+#include <optional>
 #include <pugixml.hpp>
-#include <regex>
 #include <scenario_simulator_exception/exception.hpp>
 #include <string>
+#include <system_error>
+#include <type_traits>
 #include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 namespace openscenario_interpreter
 {
 inline namespace reader
 {
+struct Substitution
+{
+  std::string::size_type begin, end;  // NOTE: [begin, end) is the range of `$(name arguments)`
+
+  std::string name, arguments;
+};
+
+/*
+   Returns the rightmost well-formed `$(name arguments)` of the given string,
+   where `name` consists of one or more characters of [A-Za-z0-9_-], at most
+   one whitespace character separates `name` and `arguments`, and `arguments`
+   runs up to the first `)`. This is what the regular expression
+   `(.*)\$\((([\w-]+)\s?([^\)]*))\)(.*)` used to capture, without building a
+   std::regex match for every attribute.
+*/
+inline auto findSubstitution(const std::string & s) -> std::optional<Substitution>
+{
+  static const auto name_characters = std::string(
+    "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+    "abcdefghijklmnopqrstuvwxyz"
+    "0123456789_-");
+
+  auto is_space = [](char c) {
+    return c == ' ' or c == '\t' or c == '\n' or c == '\v' or c == '\f' or c == '\r';
+  };
+
+  for (auto begin = s.rfind("$("); begin != std::string::npos;
+       begin = begin == 0 ? std::string::npos : s.rfind("$(", begin - 1)) {
+    if (const auto name_end = s.find_first_not_of(name_characters, begin + 2);
+        name_end != begin + 2 and name_end != std::string::npos) {
+      const auto arguments_begin = name_end + (is_space(s[name_end]) ? 1 : 0);
+      if (const auto end = s.find(')', arguments_begin); end != std::string::npos) {
+        return Substitution{
+          begin, end + 1, s.substr(begin + 2, name_end - begin - 2),
+          s.substr(arguments_begin, end - arguments_begin)};
+      }
+    }
+  }
+
+  return std::nullopt;
+}
+
 template <typename Scope>
 auto substitute(std::string attribute, Scope & scope)
 {
+  if (attribute.find('$') == std::string::npos) {
+    return attribute;  // NOTE: Most attributes contain no substitution at all.
+  }
+
   auto dirname = [](auto &&, auto && scope) { return scope.dirname(); };
 
+  auto find_pkg_prefix = [](auto && package_name, auto &&) {
+    return ament_index_cpp::get_package_prefix(package_name);
+  };
+
   auto find_pkg_share = [](auto && package_name, auto &&) {
     return ament_index_cpp::get_package_share_directory(package_name);
   };
 
   auto ros2 = [](auto && arguments, auto &&) {
+    /*
+       NOTE: `ros2 pkg prefix [--share] PACKAGE` is answered from the ament
+       index in-process. Any other command still runs `ros2` in a subprocess.
+    */
+    if (auto argv = [&]() {
+          std::vector<std::string> argv;
+          boost::split(argv, arguments, boost::is_space(), boost::token_compress_on);
+          argv.erase(
+            std::remove(std::begin(argv), std::end(argv), std::string()), std::end(argv));
+          return argv;
+        }();
+        3 <= argv.size() and argv.size() <= 4 and argv[0] == "pkg" and argv[1] == "prefix") {
+      try {
+        if (argv.size() == 3 and argv[2] != "--share") {
+          return ament_index_cpp::get_package_prefix(argv[2]);
+        } else if (argv.size() == 4 and (argv[2] == "--share" or argv[3] == "--share")) {
+          return ament_index_cpp::get_package_share_directory(
+            argv[2] == "--share" ? argv[3] : argv[2]);
+        }
+      } catch (const ament_index_cpp::PackageNotFoundError &) {
+        throw SyntaxError(
+          "The substitution `$(ros2 ", arguments, ")` failed because package ",
+          std::quoted(argv[argv[2] == "--share" ? 3 : 2]), " was not found.");
+      }
+    }
+
     auto remove_trailing_newline = [](auto && s) {
       while (s.back() == '\n') {
         s.pop_back();
@@ -79,31 +169,101 @@ auto substitute(std::string attribute, Scope & scope)
       // TODO {"eval", eval},
       // TODO {"exec-in-package", exec_in_package},
       // TODO {"find-exec", find_exec},
-      // TODO {"find-pkg-prefix", find_pkg_prefix},
+      {"find-pkg-prefix", find_pkg_prefix},
       {"find-pkg-share", find_pkg_share},
       {"ros2",
        ros2},  // NOTE: TIER IV extension (Not included in the ROS 2 Launch XML Substitution)
       {"var", var},
     };
 
-  static const auto pattern = std::regex(R"((.*)\$\((([\w-]+)\s?([^\)]*))\)(.*))");
+  /*
+     NOTE: The results of substitutions that do not depend on the scope are
+     memoized for the duration of a scenario load, so that each distinct
+     package lookup or `ros2` command runs only once per scenario.
+  */
+  static const std::unordered_set<std::string> memoizable{
+    "find-pkg-prefix",
+    "find-pkg-share",
+    "ros2",
+  };
 
-  for (std::smatch result; std::regex_match(attribute, result, pattern);) {
-    if (const auto iter = substitutions.find(result.str(3)); iter != std::end(substitutions)) {
-      attribute = result.str(1) + std::get<1>(*iter)(result.str(4), scope) + result.str(5);
+  auto apply = [&](const auto & substitution, const auto & function) -> std::string {
+    if (memoizable.count(substitution.name)) {
+      auto & memo = scope.global().substitutions;
+      const auto key = substitution.name + " " + substitution.arguments;
+      if (const auto iter = memo.find(key); iter != std::end(memo)) {
+        return iter->second;
+      } else {
+        return memo.emplace(key, function(substitution.arguments, scope)).first->second;
+      }
     } else {
-      throw SyntaxError("Unknown substitution ", std::quoted(result.str(3)), " specified");
+      return function(substitution.arguments, scope);
+    }
+  };
+
+  while (const auto substitution = findSubstitution(attribute)) {
+    if (const auto iter = substitutions.find(substitution->name); iter != std::end(substitutions)) {
+      attribute = attribute.substr(0, substitution->begin) +
+                  apply(*substitution, std::get<1>(*iter)) +
+                  attribute.substr(substitution->end);
+    } else {
+      throw SyntaxError("Unknown substitution ", std::quoted(substitution->name), " specified");
     }
   }
 
   return attribute;
 }
 
+/*
+   Reads a numeric literal with std::from_chars. Returns std::nullopt if T is
+   not a numeric type or if the string is not a plain finite numeric literal
+   (e.g. has a leading `+` or whitespace, or is `INF` or `nan`), in which case
+   the caller should fall back to boost::lexical_cast.
+
+   NOTE: std::from_chars accepts `inf`, `infinity` and `nan` in any case, but
+   `INF` must be read as the largest finite value by Double's operator>>.
+*/
+template <typename T>
+auto fromChars(const std::string & s) -> std::optional<T>
+{
+  auto from_chars = [&](auto value) -> std::optional<T> {
+    if (const auto [end, error] = std::from_chars(s.data(), s.data() + s.size(), value);
+        error == std::errc() and end == s.data() + s.size()) {
+      if constexpr (std::is_floating_point_v<decltype(value)>) {
+        if (not std::isfinite(value)) {
+          return std::nullopt;
+        }
+      }
+      return T(value);
+    } else {
+      return std::nullopt;
+    }
+  };
+
+  if constexpr (
+    std::is_same_v<T, Double> or std::is_same_v<T, Integer> or
+    std::is_same_v<T, UnsignedInteger> or std::is_same_v<T, UnsignedShort>) {
+    return from_chars(typename T::value_type());
+  } else if constexpr (std::is_arithmetic_v<T> and not std::is_same_v<T, bool>) {
+    return from_chars(T());
+  } else {
+    return std::nullopt;
+  }
+}
+
 template <typename T, typename Node, typename Scope>
 auto readAttribute(const std::string & name, const Node & node, const Scope & scope) -> T
 {
+  auto lexical_cast = [](const std::string & s) -> T {
+    if (auto value = fromChars<T>(s); value) {
+      return *value;
+    } else {
+      return boost::lexical_cast<T>(s);
+    }
+  };
+
   auto is_openscenario_standard_expression = [](const auto & s) {
-    return s.substr(0, 2) == "${" and s.back() == '}';
+    return s.compare(0, 2, "${") == 0 and s.back() == '}';
   };
 
   auto read_openscenario_standard_expression = [&](const auto & s) {
@@ -117,7 +277,7 @@ auto readAttribute(const std::string & name, const Node & node, const Scope & sc
   auto read_openscenario_standard_parameter_reference = [&](const auto & s) {
     // TODO Use `return scope.template ref<T>(s.substr(1));`
     if (auto && object = scope.ref(s.substr(1)); object) {
-      return boost::lexical_cast<T>(boost::lexical_cast<String>(object));
+      return lexical_cast(boost::lexical_cast<String>(object));
     } else {
       throw SyntaxError(
         "There is no parameter named ", std::quoted(s.substr(1)), " (Attribute ", std::quoted(name),
@@ -127,7 +287,7 @@ auto readAttribute(const std::string & name, const Node & node, const Scope & sc
 
   auto read_openscenario_standard_literal = [&](const auto & s) {
     try {
-      return boost::lexical_cast<T>(s);
+      return lexical_cast(s);
     } catch (const boost::bad_lexical_cast &) {
       throw SyntaxError(
         "Value ", std::quoted(s), " specified for attribute ", std::quoted(name),
@@ -15,6 +15,7 @@
 #ifndef OPENSCENARIO_INTERPRETER__SCOPE_HPP_
 #define OPENSCENARIO_INTERPRETER__SCOPE_HPP_
 
+#include <atomic>
 #include <boost/filesystem.hpp>
 #include <boost/lexical_cast.hpp>
 #include <boost/range/algorithm.hpp>
@@ -24,6 +25,7 @@
 #include <openscenario_interpreter/syntax/catalog_locations.hpp>
 #include <openscenario_interpreter/syntax/entity_ref.hpp>
 #include <openscenario_interpreter/utility/demangle.hpp>
+#include <typeindex>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -34,7 +36,13 @@ class EnvironmentFrame
 {
   friend struct Scope;
 
-  std::multimap<std::string, Object> variables;  // NOTE: must be ordered.
+  /*
+     NOTE: Only `equal_range` is used to look up variables, and finding two or
+     more variables of the same name and type in one breadth of the search is
+     an error anyway, so the order of variables of the same name does not
+     matter here.
+  */
+  std::unordered_multimap<std::string, Object> variables;
 
   EnvironmentFrame * const outer_frame = nullptr;
 
@@ -42,6 +50,28 @@ class EnvironmentFrame
 
   std::vector<EnvironmentFrame *> unnamed_inner_frames;
 
+  /*
+     NOTE: Results of `find` are memoized per frame, keyed by name and the
+     requested type. The result of a lookup depends only on the shape of the
+     frame tree and the variables defined in it, both of which change only
+     while a scenario is being loaded (or destroyed), so every cache is
+     discarded lazily whenever a frame is created or destroyed or a variable
+     is defined anywhere (counted by `version`). Once loading is complete, a
+     lookup is a pair of hash table probes.
+
+     The cache does not own the objects found. A frame may find an object
+     that (indirectly) owns the frame itself, e.g. an Event finding its own
+     Act, and owning it would make a reference cycle that keeps the whole
+     storyboard alive.
+  */
+  static inline std::atomic<std::size_t> version = 0;
+
+  mutable std::size_t cache_version = 0;
+
+  mutable std::unordered_map<
+    std::string, std::unordered_map<std::type_index, std::weak_ptr<Expression>>>
+    cache;
+
 #define DEFINE_SYNTAX_ERROR(TYPENAME, ...)                                                       \
   template <typename T>                                                                          \
   struct TYPENAME : public SyntaxError                                                           \
@@ -66,41 +96,29 @@ public:
 
   explicit EnvironmentFrame(EnvironmentFrame &&) = delete;
 
+  ~EnvironmentFrame();
+
   auto define(const Name &, const Object &) -> void;
 
   template <typename T>
   auto find(const Name & name) const -> Object
   {
-    // NOTE: breadth first search
-    for (std::vector<const EnvironmentFrame *> frames{this}; not frames.empty();) {
-      auto objects = [&]() {
-        std::vector<Object> result;
-        for (auto && frame : frames) {
-          boost::range::for_each(frame->variables.equal_range(name), [&](auto && name_and_value) {
-            return result.push_back(name_and_value.second);
-          });
-        }
-        return result;
-      }();
+    if (cache_version != version) {
+      cache.clear();
+      cache_version = version;
+    }
 
-      switch (boost::range::count_if(objects, is_also<T>())) {
-        case 0:
-          frames = [&]() {
-            std::vector<const EnvironmentFrame *> result;
-            for (auto && current_frame : frames) {
-              boost::range::copy(current_frame->unnamed_inner_frames, std::back_inserter(result));
-            }
-            return result;
-          }();
-          break;
-        case 1:
-          return *boost::range::find_if(objects, is_also<T>());
-        default:
-          throw AmbiguousReferenceTo<T>(name);
+    auto & objects = cache[name];
+
+    if (auto iter = objects.find(typeid(T)); iter != std::end(objects)) {
+      if (const auto object = iter->second.lock()) {
+        return Object(object, object.get());
       }
     }
 
-    return isOutermost() ? throw NoSuchVariableNamed<T>(name) : outer_frame->find<T>(name);
+    const auto object = search<T>(name);
+    objects[typeid(T)] = object;
+    return object;
   }
 
   template <typename T>
@@ -136,6 +154,42 @@ public:
   auto isOutermost() const noexcept -> bool;
 
 private:
+  template <typename T>
+  auto search(const Name & name) const -> Object
+  {
+    // NOTE: breadth first search
+    for (std::vector<const EnvironmentFrame *> frames{this}, next_frames; not frames.empty();
+         std::swap(frames, next_frames)) {
+      Object found;
+
+      std::size_t count = 0;
+
+      for (auto && frame : frames) {
+        auto [iter, end] = frame->variables.equal_range(name);
+        for (; iter != end; ++iter) {
+          if (is_also<T>()(iter->second) and count++ == 0) {
+            found = iter->second;
+          }
+        }
+      }
+
+      switch (count) {
+        case 0:
+          next_frames.clear();
+          for (auto && frame : frames) {
+            boost::range::copy(frame->unnamed_inner_frames, std::back_inserter(next_frames));
+          }
+          break;
+        case 1:
+          return found;
+        default:
+          throw AmbiguousReferenceTo<T>(name);
+      }
+    }
+
+    return isOutermost() ? throw NoSuchVariableNamed<T>(name) : outer_frame->find<T>(name);
+  }
+
   auto resolvePrefix(const Prefixed<Name> &) const -> std::list<const EnvironmentFrame *>;
 
   auto lookupFrame(const Prefixed<Name> &) const -> const EnvironmentFrame *;
@@ -179,6 +233,9 @@ class Scope
     const Entities * entities = nullptr;
 
     const CatalogLocations * catalog_locations = nullptr;
+
+    // NOTE: Memoized results of `$(...)` substitutions. See reader/attribute.hpp
+    mutable std::unordered_map<std::string, std::string> substitutions;
   };
 
   const OpenScenario * const open_scenario;
@@ -15,13 +15,18 @@
 #ifndef OPENSCENARIO_INTERPRETER__SIMULATOR_CORE_HPP_
 #define OPENSCENARIO_INTERPRETER__SIMULATOR_CORE_HPP_
 
+#include <functional>
+#include <map>
 #include <openscenario_interpreter/error.hpp>
 #include <openscenario_interpreter/syntax/boolean.hpp>
 #include <openscenario_interpreter/syntax/double.hpp>
 #include <openscenario_interpreter/syntax/routing_algorithm.hpp>
 #include <openscenario_interpreter/syntax/string.hpp>
 #include <openscenario_interpreter/syntax/unsigned_integer.hpp>
+#include <string>
 #include <traffic_simulator/api/api.hpp>
+#include <tuple>
+#include <type_traits>
 
 namespace openscenario_interpreter
 {
@@ -37,12 +42,81 @@ class SimulatorCore
 {
   static inline std::unique_ptr<traffic_simulator::API> core = nullptr;
 
+  /*
+     The HD map of the last simulator core deactivated in batch mode. Holding
+     it keeps the map (and the caches warmed up by the previous scenario)
+     alive until the next activation, so that the next scenario on the same
+     map gets it from hdmap_utils::HdMapUtils::load instead of loading it
+     again.
+  */
+  static inline std::shared_ptr<hdmap_utils::HdMapUtils> retained_map = nullptr;
+
+  /*
+     The number of times the state of the simulator core may have been changed
+     since it was activated. Results memoized by `memoize` are discarded when
+     this value changes, that is, every frame (SimulatorCore::update) and
+     every action applied to entities. Every function of this class that
+     changes the state of entities must increment it, since some actions
+     take effect immediately (e.g. SpeedAction with the step transition sets
+     the speed of the entity in place).
+  */
+  static inline std::size_t epoch = 0;
+
+  template <typename T>
+  using MemoizationKey = std::conditional_t<
+    std::is_base_of_v<std::string, std::decay_t<T>>, std::string, std::decay_t<T>>;
+
+  template <typename T>
+  static constexpr auto isMemoizable =
+    std::is_base_of_v<std::string, std::decay_t<T>> or std::is_arithmetic_v<std::decay_t<T>> or
+    std::is_enum_v<std::decay_t<T>>;
+
+  /*
+     Returns the result of `function(xs...)` calculated earlier in the same
+     epoch if any. Conditions often evaluate the same query for the same pair
+     of entities (e.g. the three components of a relative pose), and some of
+     the queries require routing on the lanelet map.
+
+     Queries with arguments that cannot be used as a key (e.g. poses) are not
+     memoized. The cache is distinguished by the type of `function`, so each
+     call site must pass its own lambda expression.
+  */
+  template <typename Function, typename... Ts>
+  static auto memoize(Function && function, Ts &&... xs)
+  {
+    using Result = std::decay_t<std::invoke_result_t<Function, Ts...>>;
+
+    if constexpr ((isMemoizable<Ts> and ...)) {
+      static std::map<std::tuple<MemoizationKey<Ts>...>, Result> cache;
+
+      static auto cached_epoch = epoch;
+
+      if (cached_epoch != epoch) {
+        cache.clear();
+        cached_epoch = epoch;
+      }
+
+      auto key = std::tuple<MemoizationKey<Ts>...>(xs...);
+
+      if (const auto iter = cache.find(key); iter != std::end(cache)) {
+        return iter->second;
+      } else {
+        return cache
+          .emplace(std::move(key), std::invoke(function, std::forward<decltype(xs)>(xs)...))
+          .first->second;
+      }
+    } else {
+      return Result(std::invoke(function, std::forward<decltype(xs)>(xs)...));
+    }
+  }
+
 public:
   template <typename Node, typename... Ts>
   static auto activate(
     const Node & node, const traffic_simulator::Configuration & configuration, Ts &&... xs) -> void
   {
     if (not active()) {
+      ++epoch;
       core = std::make_unique<traffic_simulator::API>(
         node, configuration, std::forward<decltype(xs)>(xs)...);
     } else {
@@ -52,16 +126,24 @@ public:
 
   static auto active() { return static_cast<bool>(core); }
 
-  static auto deactivate() -> void
+  static auto deactivate(bool retain_map = false) -> void
   {
     if (active()) {
+      ++epoch;
+      retained_map = retain_map ? core->getHdmapUtils() : nullptr;
       core->despawnEntities();
       core->closeZMQConnection();
       core.reset();
+    } else if (not retain_map) {
+      retained_map.reset();
     }
   }
 
-  static auto update() -> void { core->updateFrame(); }
+  static auto update() -> void
+  {
+    ++epoch;
+    core->updateFrame();
+  }
 
   class CoordinateSystemConversion
   {
@@ -132,19 +214,23 @@ public:
     template <typename... Ts>
     static auto makeNativeRelativeWorldPosition(Ts &&... xs)
     {
-      try {
-        return SimulatorCore::core->getRelativePose(std::forward<decltype(xs)>(xs)...);
-      } catch (...) {
-        geometry_msgs::msg::Pose result{};
-        result.position.x = std::numeric_limits<double>::quiet_NaN();
-        result.position.y = std::numeric_limits<double>::quiet_NaN();
-        result.position.z = std::numeric_limits<double>::quiet_NaN();
-        result.orientation.x = 0;
-        result.orientation.y = 0;
-        result.orientation.z = 0;
-        result.orientation.w = 1;
-        return result;
-      }
+      return memoize(
+        [](auto &&... xs) {
+          try {
+            return SimulatorCore::core->getRelativePose(std::forward<decltype(xs)>(xs)...);
+          } catch (...) {
+            geometry_msgs::msg::Pose result{};
+            result.position.x = std::numeric_limits<double>::quiet_NaN();
+            result.position.y = std::numeric_limits<double>::quiet_NaN();
+            result.position.z = std::numeric_limits<double>::quiet_NaN();
+            result.orientation.x = 0;
+            result.orientation.y = 0;
+            result.orientation.z = 0;
+            result.orientation.w = 1;
+            return result;
+          }
+        },
+        std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename From, typename To>
@@ -178,8 +264,8 @@ public:
         traffic_simulator::LaneletPose position;
         position.lanelet_id = std::numeric_limits<std::int64_t>::max();
         bool allow_lane_change = (routing_algorithm == RoutingAlgorithm::value_type::shortest);
-        position.s = s(from, to, false, true, allow_lane_change);
-        position.offset = t(from, to, allow_lane_change);
+        position.s = memoize(s, from, to, false, true, allow_lane_change);
+        position.offset = memoize(t, from, to, allow_lane_change);
         position.rpy.x = std::numeric_limits<double>::quiet_NaN();
         position.rpy.y = std::numeric_limits<double>::quiet_NaN();
         position.rpy.z = std::numeric_limits<double>::quiet_NaN();
@@ -233,8 +319,8 @@ public:
         traffic_simulator::LaneletPose position;
         position.lanelet_id = std::numeric_limits<std::int64_t>::max();
         bool allow_lane_change = (routing_algorithm == RoutingAlgorithm::value_type::shortest);
-        position.s = s(from, to, false, true, allow_lane_change);
-        position.offset = t(from, to, allow_lane_change);
+        position.s = memoize(s, from, to, false, true, allow_lane_change);
+        position.offset = memoize(t, from, to, allow_lane_change);
         position.rpy.x = std::numeric_limits<double>::quiet_NaN();
         position.rpy.y = std::numeric_limits<double>::quiet_NaN();
         position.rpy.z = std::numeric_limits<double>::quiet_NaN();
@@ -258,21 +344,25 @@ public:
     template <typename... Ts>
     static auto makeNativeBoundingBoxRelativeWorldPosition(Ts &&... xs)
     {
-      if (const auto result =
-            SimulatorCore::core->getBoundingBoxRelativePose(std::forward<decltype(xs)>(xs)...);
-          result) {
-        return result.value();
-      } else {
-        geometry_msgs::msg::Pose result_empty{};
-        result_empty.position.x = std::numeric_limits<double>::quiet_NaN();
-        result_empty.position.y = std::numeric_limits<double>::quiet_NaN();
-        result_empty.position.z = std::numeric_limits<double>::quiet_NaN();
-        result_empty.orientation.x = 0;
-        result_empty.orientation.y = 0;
-        result_empty.orientation.z = 0;
-        result_empty.orientation.w = 1;
-        return result_empty;
-      }
+      return memoize(
+        [](auto &&... xs) {
+          if (const auto result = SimulatorCore::core->getBoundingBoxRelativePose(
+                std::forward<decltype(xs)>(xs)...);
+              result) {
+            return result.value();
+          } else {
+            geometry_msgs::msg::Pose result_empty{};
+            result_empty.position.x = std::numeric_limits<double>::quiet_NaN();
+            result_empty.position.y = std::numeric_limits<double>::quiet_NaN();
+            result_empty.position.z = std::numeric_limits<double>::quiet_NaN();
+            result_empty.orientation.x = 0;
+            result_empty.orientation.y = 0;
+            result_empty.orientation.z = 0;
+            result_empty.orientation.w = 1;
+            return result_empty;
+          }
+        },
+        std::forward<decltype(xs)>(xs)...);
     }
   };
 
@@ -282,12 +372,14 @@ public:
     template <typename... Ts>
     static auto applyAcquirePositionAction(Ts &&... xs)
     {
+      ++epoch;
       return core->requestAcquirePosition(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applyAddEntityAction(Ts &&... xs)
     {
+      ++epoch;
       return core->spawn(std::forward<decltype(xs)>(xs)...);
     }
 
@@ -295,6 +387,7 @@ public:
     static auto applyProfileAction(
       const EntityRef & entity_ref, const DynamicConstraints & dynamic_constraints) -> void
     {
+      ++epoch;
       return core->setBehaviorParameter(entity_ref, [&]() {
         auto behavior_parameter = core->getBehaviorParameter(entity_ref);
 
@@ -330,6 +423,7 @@ public:
     static auto applyAssignControllerAction(
       const std::string & entity_ref, Controller && controller) -> void
     {
+      ++epoch;
       core->setVelocityLimit(
         entity_ref, controller.properties.template get<Double>(
                       "maxSpeed", std::numeric_limits<Double::value_type>::max()));
@@ -432,42 +526,49 @@ public:
     template <typename... Ts>
     static auto applyAssignRouteAction(Ts &&... xs)
     {
+      ++epoch;
       return core->requestAssignRoute(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applyDeleteEntityAction(Ts &&... xs)
     {
+      ++epoch;
       return core->despawn(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applyFollowTrajectoryAction(Ts &&... xs)
     {
+      ++epoch;
       return core->requestFollowTrajectory(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applyLaneChangeAction(Ts &&... xs)
     {
+      ++epoch;
       return core->requestLaneChange(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applySpeedAction(Ts &&... xs)
     {
+      ++epoch;
       return core->requestSpeedChange(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applyTeleportAction(Ts &&... xs)
     {
+      ++epoch;
       return core->setEntityStatus(std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto applyWalkStraightAction(Ts &&... xs)
     {
+      ++epoch;
       return core->requestWalkStraight(std::forward<decltype(xs)>(xs)...);
     }
   };
@@ -485,19 +586,25 @@ public:
     template <typename... Ts>
     static auto evaluateCollisionCondition(Ts &&... xs) -> bool
     {
-      return core->checkCollision(std::forward<decltype(xs)>(xs)...);
+      return memoize(
+        [](auto &&... xs) { return core->checkCollision(std::forward<decltype(xs)>(xs)...); },
+        std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
     static auto evaluateBoundingBoxEuclideanDistance(Ts &&... xs)  // for RelativeDistanceCondition
     {
-      if (const auto result = core->getBoundingBoxDistance(std::forward<decltype(xs)>(xs)...);
-          result) {
-        return result.value();
-      } else {
-        using value_type = typename std::decay<decltype(result)>::type::value_type;
-        return std::numeric_limits<value_type>::quiet_NaN();
-      }
+      return memoize(
+        [](auto &&... xs) {
+          if (const auto result = core->getBoundingBoxDistance(std::forward<decltype(xs)>(xs)...);
+              result) {
+            return result.value();
+          } else {
+            using value_type = typename std::decay<decltype(result)>::type::value_type;
+            return std::numeric_limits<value_type>::quiet_NaN();
+          }
+        },
+        std::forward<decltype(xs)>(xs)...);
     }
 
     template <typename... Ts>
@@ -525,12 +632,17 @@ public:
     template <typename... Ts>
     static auto evaluateTimeHeadway(Ts &&... xs)
     {
-      if (const auto result = core->getTimeHeadway(std::forward<decltype(xs)>(xs)...); result) {
-        return result.value();
-      } else {
-        using value_type = typename std::decay<decltype(result)>::type::value_type;
-        return std::numeric_limits<value_type>::quiet_NaN();
-      }
+      return memoize(
+        [](auto &&... xs) {
+          if (const auto result = core->getTimeHeadway(std::forward<decltype(xs)>(xs)...);
+              result) {
+            return result.value();
+          } else {
+            using value_type = typename std::decay<decltype(result)>::type::value_type;
+            return std::numeric_limits<value_type>::quiet_NaN();
+          }
+        },
+        std::forward<decltype(xs)>(xs)...);
     }
   };
 
@@ -556,6 +668,7 @@ public:
 
     static auto activateNonUserDefinedControllers() -> decltype(auto)
     {
+      ++epoch;
       return core->startNpcLogic();
     }
 
@@ -29,11 +29,14 @@ inline namespace syntax
  *    <xsd:all>
  *      <xsd:element name="Range" type="Range"/>
  *    </xsd:all>
+ *    <xsd:attribute name="stepWidth" type="Double" use="required"/>
  *  </xsd:complexType>
  *
  * -------------------------------------------------------------------------- */
 struct DistributionRange : private Scope, public ComplexType
 {
+  const Double step_width;
+
   const Range range;
 
   explicit DistributionRange(const pugi::xml_node &, Scope &);
@@ -44,7 +44,6 @@ struct Histogram : public ComplexType, private Scope
   {
     explicit BinAdaptor(const std::list<HistogramBin> & bins)
     {
-      intervals.emplace_back(bins.front().range.lower_limit.data);
       for (const auto & bin : bins) {
         intervals.emplace_back(bin.range.lower_limit.data);
         densities.emplace_back(bin.weight.data);
@@ -50,6 +50,11 @@ struct ParameterCondition : private Scope
   /*  */ auto description() const -> String;
 
   /*  */ auto evaluate() const -> Object;
+
+private:
+  mutable Object parameter;  // NOTE: Resolved from `parameter_ref` on first use.
+
+  auto resolve() const -> const Object &;
 };
 }  // namespace syntax
 }  // namespace openscenario_interpreter
@@ -45,6 +45,9 @@ struct ParameterModifyAction : Scope
   static auto run() noexcept -> void;
 
   /*  */ auto start() const -> void;
+
+private:
+  mutable Object parameter;  // NOTE: Resolved from `parameter_ref` on first use.
 };
 }  // namespace syntax
 }  // namespace openscenario_interpreter
@@ -44,7 +44,12 @@ struct ParameterSetAction : private Scope
 
   static auto set(const Scope & scope, const String &, const String &) -> void;
 
+  static auto set(const Object &, const String &) -> void;
+
   /*  */ auto start() const -> void;
+
+private:
+  mutable Object parameter;  // NOTE: Resolved from `parameter_ref` on first use.
 };
 }  // namespace syntax
 }  // namespace openscenario_interpreter
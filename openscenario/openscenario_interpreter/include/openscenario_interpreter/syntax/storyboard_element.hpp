@@ -31,6 +31,8 @@
 
 namespace openscenario_interpreter
 {
+class ContextPublisher;
+
 inline namespace syntax
 {
 class StoryboardElement : private SimulatorCore::ConditionEvaluation
@@ -53,6 +55,8 @@ private:
     StoryboardElementState::value_type, std::vector<std::function<void(const StoryboardElement &)>>>
     callbacks;
 
+  friend class openscenario_interpreter::ContextPublisher;
+
 public:
   // Storyboard
   explicit StoryboardElement(const Trigger & stop_trigger)  //
@@ -24,6 +24,8 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+class StoryboardElement;
+
 /* ---- StoryboardElementStateCondition ----------------------------------------
  *
  *  <xsd:complexType name="StoryboardElementStateCondition">
@@ -43,6 +45,9 @@ struct StoryboardElementStateCondition : private Scope
 
   StoryboardElementState current_state;
 
+  // NOTE: Resolved from `storyboard_element_ref` once the Storyboard has been loaded.
+  const StoryboardElement * storyboard_element = nullptr;
+
   explicit StoryboardElementStateCondition(const pugi::xml_node &, const Scope &);
 
   auto description() const -> String;
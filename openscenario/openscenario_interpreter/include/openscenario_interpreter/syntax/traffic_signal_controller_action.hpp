@@ -23,6 +23,8 @@ namespace openscenario_interpreter
 {
 inline namespace syntax
 {
+struct TrafficSignalController;
+
 /* ---- NOTE -------------------------------------------------------------------
  *
  *  Sets a specific phase of a traffic signal controller, typically affecting a
@@ -54,6 +56,10 @@ struct TrafficSignalControllerAction : public Scope
   static auto run() noexcept -> void;
 
   /*  */ auto start() -> void;
+
+private:
+  // NOTE: Resolved from `traffic_signal_controller_ref` on first use.
+  TrafficSignalController * traffic_signal_controller = nullptr;
 };
 }  // namespace syntax
 }  // namespace openscenario_interpreter
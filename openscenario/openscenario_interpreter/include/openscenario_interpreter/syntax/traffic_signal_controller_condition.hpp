@@ -49,6 +49,9 @@ struct TrafficSignalControllerCondition
 
   Scope scope;
 
+  // NOTE: Resolved from `traffic_signal_controller_ref` on first use.
+  const TrafficSignalController * traffic_signal_controller = nullptr;
+
   explicit TrafficSignalControllerCondition(const pugi::xml_node &, const Scope &);
 
   auto description() const -> String;
@@ -0,0 +1,285 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <boost/lexical_cast.hpp>
+#include <openscenario_interpreter/context_publisher.hpp>
+#include <openscenario_interpreter/syntax/act.hpp>
+#include <openscenario_interpreter/syntax/action.hpp>
+#include <openscenario_interpreter/syntax/event.hpp>
+#include <openscenario_interpreter/syntax/maneuver.hpp>
+#include <openscenario_interpreter/syntax/maneuver_group.hpp>
+#include <openscenario_interpreter/syntax/scenario_definition.hpp>
+#include <openscenario_interpreter/syntax/story.hpp>
+#include <openscenario_interpreter/syntax/storyboard.hpp>
+#include <openscenario_interpreter/utility/overload.hpp>
+#include <typeindex>
+#include <unordered_map>
+
+namespace openscenario_interpreter
+{
+ContextPublisher::ContextPublisher(
+  const OpenScenario & script, const std::shared_ptr<Publisher> & publisher_of_context,
+  const std::shared_ptr<Publisher> & publisher_of_context_delta)
+: publisher_of_context(publisher_of_context),
+  publisher_of_context_delta(publisher_of_context_delta),
+  script(script)
+{
+  // clang-format off
+  for (const auto & [state, name] : std::vector<std::pair<const Object *, std::string>> {
+         { &openscenario_interpreter::complete_state,   "completeState"   },
+         { &openscenario_interpreter::running_state,    "runningState"    },
+         { &openscenario_interpreter::standby_state,    "standbyState"    },
+         { &openscenario_interpreter::start_transition, "startTransition" },
+         { &openscenario_interpreter::stop_transition,  "stopTransition"  },
+       })
+  // clang-format on
+  {
+    probe("/CurrentStates/" + name, [state = state]() -> Value { return state->use_count() - 1; });
+  }
+
+  if (script.category.is<ScenarioDefinition>()) {
+    probe(
+      "/OpenSCENARIO/Storyboard", script.category.as<ScenarioDefinition>().storyboard,
+      typeid(Storyboard));
+  }
+
+  context << script;
+
+  for (const auto & probe : probes) {
+    previous_values.push_back(probe.get());
+  }
+
+  worker = std::thread([this]() {
+    std::size_t subscription_count = 0;
+    for (auto is_first = true;; is_first = false) {
+      auto lock = std::unique_lock(snapshots_mutex);
+      snapshots_condition.wait(
+        lock, [this]() { return is_stop_requested or not snapshots.empty(); });
+      if (snapshots.empty()) {
+        return;
+      } else {
+        auto snapshot = std::move(snapshots.front());
+        snapshots.pop_front();
+        lock.unlock();
+
+        const auto is_joined = [&]() {
+          if (not publisher_of_context_delta) {
+            return false;
+          } else {
+            auto count = std::exchange(
+              subscription_count, publisher_of_context_delta->get_subscription_count());
+            return count < subscription_count;
+          }
+        }();
+
+        if (auto patch = write(snapshot);
+            not publisher_of_context_delta or is_first or is_joined or snapshot.is_full) {
+          /*
+             When publishing deltas, the full context is published only when
+             a subscriber cannot apply the subsequent deltas to its copy
+             otherwise.
+          */
+          publisher_of_context->publish(makeContext(snapshot, context));
+        } else {
+          publisher_of_context_delta->publish(makeContext(snapshot, patch));
+        }
+      }
+    }
+  });
+}
+
+ContextPublisher::~ContextPublisher()
+{
+  {
+    auto lock = std::lock_guard(snapshots_mutex);
+    is_stop_requested = true;
+  }
+
+  snapshots_condition.notify_one();
+
+  if (worker.joinable()) {
+    worker.join();  // NOTE: Snapshots already handed over are published before joining.
+  }
+}
+
+auto ContextPublisher::publish(const rclcpp::Time & stamp, double time) -> void
+{
+  /*
+     If the worker thread cannot keep up with the publication, snapshots not
+     yet published are superseded by the latest one, since each full context
+     is self-contained. Deltas are dropped only when too many of them are
+     pending, superseded by a snapshot published as a full context, since the
+     description of a Condition is taken only when its value changes.
+  */
+  is_full_snapshot_taken = [this]() {
+    auto lock = std::lock_guard(snapshots_mutex);
+    return not publisher_of_context_delta or max_snapshots <= snapshots.size();
+  }();
+
+  Snapshot snapshot{stamp, time, script.frame, {}, is_full_snapshot_taken};
+
+  snapshot.values.reserve(probes.size());
+
+  for (const auto & probe : probes) {
+    snapshot.values.push_back(probe.get());
+  }
+
+  {
+    auto lock = std::lock_guard(snapshots_mutex);
+
+    if (snapshot.is_full) {
+      snapshots.clear();
+    }
+
+    snapshots.push_back(std::move(snapshot));
+  }
+
+  snapshots_condition.notify_one();
+}
+
+auto ContextPublisher::makeContext(const Snapshot & snapshot, const nlohmann::json & json)
+  -> Context
+{
+  Context message;
+  {
+    message.stamp = snapshot.stamp;
+    message.data = json.dump();
+    message.time = snapshot.time;
+  }
+
+  return message;
+}
+
+auto ContextPublisher::probe(const std::string & path, std::function<Value()> && get) -> void
+{
+  probes.push_back({nlohmann::json::json_pointer(path), std::move(get)});
+}
+
+auto ContextPublisher::probe(const std::string & path, const Trigger & trigger) -> void
+{
+  probe(path + "/currentValue", [&trigger]() -> Value { return trigger.current_value; });
+
+  std::size_t i = 0;
+
+  for (const auto & condition_group : trigger) {
+    const auto prefix = path + "/ConditionGroup/" + std::to_string(i++);
+
+    probe(prefix + "/currentValue", [&condition_group]() -> Value {
+      return condition_group.current_value;
+    });
+
+    std::size_t j = 0;
+
+    for (const auto & condition : condition_group) {
+      probe(
+        prefix + "/Condition/" + std::to_string(j++),
+        [this, &condition, previous = std::optional<bool>()]() mutable -> Value {
+          if (not is_full_snapshot_taken and previous == condition.current_value) {
+            return ConditionValue{condition.current_value, std::nullopt};
+          } else {
+            previous = condition.current_value;
+            return ConditionValue{condition.current_value, condition.description()};
+          }
+        });
+    }
+  }
+}
+
+auto ContextPublisher::probe(
+  const std::string & path, const StoryboardElement & element, const std::type_info & type) -> void
+{
+  probe(path + "/currentState", [&element]() -> Value { return element.state().get(); });
+
+  if (type == typeid(ManeuverGroup) or type == typeid(Event)) {
+    probe(path + "/currentExecutionCount", [&element]() -> Value {
+      return static_cast<long>(element.current_execution_count);
+    });
+  }
+
+  if (type == typeid(Event)) {
+    probe(path + "/StartTrigger", element.start_trigger);
+  }
+
+  // NOTE: Must be consistent with the JSON written by `operator<<(nlohmann::json &, ...)`.
+  static const std::unordered_map<std::type_index, std::string> names{
+    {typeid(Story), "Story"},
+    {typeid(Act), "Act"},
+    {typeid(ManeuverGroup), "ManeuverGroup"},
+    {typeid(Maneuver), "Maneuver"},
+    {typeid(Event), "Event"},
+    {typeid(Action), "Action"},
+  };
+
+  std::unordered_map<std::string, std::size_t> indices;
+
+  for (const auto & each : element.elements) {
+    if (const auto iter = names.find(each.type()); iter != std::end(names)) {
+      probe(
+        path + "/" + iter->second + "/" + std::to_string(indices[iter->second]++),
+        each.as<StoryboardElement>(), each.type());
+    }
+  }
+}
+
+auto ContextPublisher::write(const Snapshot & snapshot) -> nlohmann::json
+{
+  auto patch = nlohmann::json::array();
+
+  auto replace = [&](const nlohmann::json::json_pointer & pointer, const nlohmann::json & value) {
+    context[pointer] = value;
+    patch.push_back({{"op", "replace"}, {"path", pointer.to_string()}, {"value", value}});
+  };
+
+  replace(nlohmann::json::json_pointer("/frame"), snapshot.frame);
+
+  for (std::size_t i = 0; i < probes.size(); ++i) {
+    const auto & pointer = probes[i].pointer;
+    const auto & value = snapshot.values[i];
+    std::visit(
+      overload(
+        [&](const ConditionValue & condition) {
+          if (condition.description) {
+            replace(pointer / "currentEvaluation", *condition.description);
+          }
+          if (value != previous_values[i]) {
+            replace(
+              pointer / "currentValue",
+              boost::lexical_cast<std::string>(Boolean(condition.value)));
+          }
+        },
+        [&](const Expression * state) {
+          if (value != previous_values[i]) {
+            replace(
+              pointer, boost::lexical_cast<std::string>(
+                         dynamic_cast<const StoryboardElementState &>(*state)));
+          }
+        },
+        [&](bool boolean) {
+          if (value != previous_values[i]) {
+            replace(pointer, boost::lexical_cast<std::string>(Boolean(boolean)));
+          }
+        },
+        [&](long count) {
+          if (value != previous_values[i]) {
+            replace(pointer, count);
+          }
+        }),
+      value);
+  }
+
+  previous_values = snapshot.values;
+
+  return patch;
+}
+}  // namespace openscenario_interpreter
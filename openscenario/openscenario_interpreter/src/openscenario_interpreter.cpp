@@ -17,6 +17,7 @@
 #include <algorithm>
 #include <nlohmann/json.hpp>
 #include <openscenario_interpreter/openscenario_interpreter.hpp>
+#include <openscenario_interpreter/parameter_store.hpp>
 #include <openscenario_interpreter/record.hpp>
 #include <openscenario_interpreter/syntax/object_controller.hpp>
 #include <openscenario_interpreter/syntax/parameter_value_distribution.hpp>
@@ -35,21 +36,36 @@ namespace openscenario_interpreter
 Interpreter::Interpreter(const rclcpp::NodeOptions & options)
 : rclcpp_lifecycle::LifecycleNode("openscenario_interpreter", options),
   publisher_of_context(create_publisher<Context>("context", rclcpp::QoS(1).transient_local())),
+  publisher_of_context_delta(
+    create_publisher<Context>("context/delta", rclcpp::QoS(rclcpp::KeepLast(100)).reliable())),
+  as_fast_as_possible(false),
+  batch_mode(false),
+  context_publish_rate(0),
   local_frame_rate(30),
   local_real_time_factor(1.0),
   osc_path(""),
   output_directory("/tmp"),
+  publish_context_delta(false),
   record(false)
 {
+  DECLARE_PARAMETER(as_fast_as_possible);
+  DECLARE_PARAMETER(batch_mode);
+  DECLARE_PARAMETER(context_publish_rate);
   DECLARE_PARAMETER(local_frame_rate);
   DECLARE_PARAMETER(local_real_time_factor);
   DECLARE_PARAMETER(osc_path);
   DECLARE_PARAMETER(output_directory);
+  DECLARE_PARAMETER(publish_context_delta);
   DECLARE_PARAMETER(record);
 }
 
 Interpreter::~Interpreter() {}
 
+auto Interpreter::currentContextPublishRate() const -> std::chrono::milliseconds
+{
+  return std::chrono::milliseconds(static_cast<unsigned int>(1 / context_publish_rate * 1000));
+}
+
 auto Interpreter::currentLocalFrameRate() const -> std::chrono::milliseconds
 {
   return std::chrono::milliseconds(static_cast<unsigned int>(1 / local_frame_rate * 1000));
@@ -97,14 +113,27 @@ auto Interpreter::on_configure(const rclcpp_lifecycle::State &) -> Result
         "Timeout",
         "The simulation time has exceeded the time specified by the scenario_test_runner.");
 
-      std::this_thread::sleep_for(std::chrono::seconds(1));  // NOTE: Wait for parameters to be set.
+      /*
+         NOTE: Wait for parameters to be set. In batch mode, the parameters
+         are expected to be set by a client that waits for the response of
+         set_parameters before requesting the configure transition (as
+         scenario_test_runner does), so there is nothing to wait for.
+      */
+      if (GET_PARAMETER(batch_mode); not batch_mode) {
+        std::this_thread::sleep_for(std::chrono::seconds(1));
+      }
 
+      GET_PARAMETER(as_fast_as_possible);
+      GET_PARAMETER(context_publish_rate);
       GET_PARAMETER(local_frame_rate);
       GET_PARAMETER(local_real_time_factor);
       GET_PARAMETER(osc_path);
       GET_PARAMETER(output_directory);
+      GET_PARAMETER(publish_context_delta);
       GET_PARAMETER(record);
 
+      ParameterStore::use(get_node_parameters_interface());
+
       script = std::make_shared<OpenScenario>(osc_path);
 
       if (script->category.is<ScenarioDefinition>()) {
@@ -162,6 +191,13 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
   auto evaluate_storyboard = [this]() {
     withExceptionHandler(
       [this](auto &&...) {
+        /*
+           NOTE: Stop the publication by the worker thread before publishing
+           the final context, so that it will not be overwritten by the
+           context of an older frame.
+        */
+        timer_of_context.reset();
+        context_publisher.reset();
         publishCurrentContext();
         deactivate();
       },
@@ -183,7 +219,9 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
 
           SimulatorCore::update();
 
-          publishCurrentContext();
+          if (not timer_of_context) {
+            publishContext();
+          }
         });
       });
   };
@@ -193,6 +231,8 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
   } else {
     return withExceptionHandler(
       [this](auto &&...) {
+        timer_of_context.reset();
+        context_publisher.reset();
         publishCurrentContext();
         reset();
         return Interpreter::Result::FAILURE;  // => Inactive
@@ -230,7 +270,31 @@ auto Interpreter::on_activate(const rclcpp_lifecycle::State &) -> Result
           throw Error("No script evaluable.");
         }
 
-        timer = create_wall_timer(currentLocalFrameRate(), evaluate_storyboard);
+        if (publish_context_delta) {
+          publisher_of_context_delta->on_activate();
+        }
+
+        context_publisher = std::make_unique<ContextPublisher>(
+          *script, publisher_of_context,
+          publish_context_delta ? publisher_of_context_delta : nullptr);
+
+        if (0 < context_publish_rate) {
+          timer_of_context =
+            create_wall_timer(currentContextPublishRate(), [this]() { publishContext(); });
+        }
+
+        /*
+           In as-fast-as-possible mode, the next frame is evaluated as soon as
+           the executor is idle again after the previous one. The simulation
+           time does not depend on the wall clock in either mode, because
+           SimulationClock advances by local_real_time_factor /
+           local_frame_rate seconds on every SimulatorCore::update; only the
+           wall-clock pace changes. This mode is intended for scenarios without
+           Autoware, which runs on the wall clock.
+        */
+        timer = create_wall_timer(
+          as_fast_as_possible ? std::chrono::milliseconds(0) : currentLocalFrameRate(),
+          evaluate_storyboard);
 
         return Interpreter::Result::SUCCESS;  // => Active
       });
@@ -261,12 +325,23 @@ auto Interpreter::on_error(const rclcpp_lifecycle::State &) -> Result
 auto Interpreter::on_shutdown(const rclcpp_lifecycle::State &) -> Result
 {
   timer.reset();
+  timer_of_context.reset();
+  context_publisher.reset();
   scenarios.clear();
   script.reset();
   SimulatorCore::deactivate();
   return Interpreter::Result::SUCCESS;  // => Finalized
 }
 
+auto Interpreter::publishContext() -> void
+{
+  if (context_publisher) {
+    context_publisher->publish(now(), evaluateSimulationTime());
+  } else {
+    publishCurrentContext();
+  }
+}
+
 auto Interpreter::publishCurrentContext() const -> void
 {
   Context context;
@@ -284,10 +359,18 @@ auto Interpreter::reset() -> void
 {
   timer.reset();  // Stop scenario evaluation
 
+  timer_of_context.reset();
+
+  context_publisher.reset();
+
   if (publisher_of_context->is_activated()) {
     publisher_of_context->on_deactivate();
   }
 
+  if (publisher_of_context_delta->is_activated()) {
+    publisher_of_context_delta->on_deactivate();
+  }
+
   if (not has_parameter("initialize_duration")) {
     declare_parameter<int>("initialize_duration", 30);
   }
@@ -307,7 +390,8 @@ auto Interpreter::reset() -> void
      core to be deactivated.
   */
   common::status_monitor.overrideThreshold(
-    std::chrono::seconds(get_parameter("initialize_duration").as_int()), SimulatorCore::deactivate);
+    std::chrono::seconds(get_parameter("initialize_duration").as_int()),
+    [this]() { SimulatorCore::deactivate(batch_mode); });
 
   scenarios.pop_front();
 
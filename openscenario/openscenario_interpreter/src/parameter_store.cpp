@@ -0,0 +1,47 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <openscenario_interpreter/parameter_store.hpp>
+#include <rclcpp/node.hpp>
+
+namespace openscenario_interpreter
+{
+auto ParameterStore::use(const std::shared_ptr<Source> & given) -> void
+{
+  auto lock = std::lock_guard(mutex);
+  source = given;
+  values.clear();
+}
+
+auto ParameterStore::get(const std::string & name, const rclcpp::ParameterValue & default_value)
+  -> rclcpp::ParameterValue
+{
+  auto lock = std::lock_guard(mutex);
+
+  if (const auto iter = values.find(name); iter != std::end(values)) {
+    return iter->second;
+  } else {
+    if (not source) {
+      static auto node = std::make_shared<rclcpp::Node>("get_parameter", "simulation");
+      source = node->get_node_parameters_interface();
+    }
+
+    if (not source->has_parameter(name)) {
+      source->declare_parameter(name, default_value);
+    }
+
+    return values.emplace(name, source->get_parameter(name).get_parameter_value()).first->second;
+  }
+}
+}  // namespace openscenario_interpreter
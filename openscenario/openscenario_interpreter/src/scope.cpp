@@ -26,6 +26,8 @@ namespace openscenario_interpreter
 EnvironmentFrame::EnvironmentFrame(EnvironmentFrame & outer_frame, const std::string & name)
 : outer_frame(&outer_frame)
 {
+  ++version;
+
   if (name.empty()) {
     outer_frame.unnamed_inner_frames.push_back(this);
   } else {
@@ -33,8 +35,11 @@ EnvironmentFrame::EnvironmentFrame(EnvironmentFrame & outer_frame, const std::st
   }
 }
 
+EnvironmentFrame::~EnvironmentFrame() { ++version; }
+
 auto EnvironmentFrame::define(const Name & name, const Object & object) -> void
 {
+  ++version;
   variables.emplace(name, object);
 }
 
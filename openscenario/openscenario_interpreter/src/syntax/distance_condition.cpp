@@ -13,6 +13,7 @@
 // limitations under the License.
 
 #include <cmath>
+#include <openscenario_interpreter/parameter_store.hpp>
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/reader/element.hpp>
 #include <openscenario_interpreter/simulator_core.hpp>
@@ -21,7 +22,6 @@
 #include <openscenario_interpreter/syntax/scenario_object.hpp>
 #include <openscenario_interpreter/utility/overload.hpp>
 #include <openscenario_interpreter/utility/print.hpp>
-#include <rclcpp/rclcpp.hpp>
 #include <sstream>
 
 // NOTE: Ignore spell miss due to OpenSCENARIO standard.
@@ -46,11 +46,7 @@ DistanceCondition::DistanceCondition(
   position(readElement<Position>("Position", node, scope)),
   triggering_entities(triggering_entities),
   results(triggering_entities.entity_refs.size(), Double::nan()),
-  consider_z([]() {
-    rclcpp::Node node{"get_parameter", "simulation"};
-    node.declare_parameter("consider_pose_by_road_slope", false);
-    return node.get_parameter("consider_pose_by_road_slope").as_bool();
-  }())
+  consider_z(ParameterStore::get("consider_pose_by_road_slope", false))
 {
 }
 
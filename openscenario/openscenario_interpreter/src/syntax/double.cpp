@@ -13,11 +13,12 @@
 // limitations under the License.
 
 #include <boost/lexical_cast.hpp>
+#include <charconv>
 #include <iomanip>
 #include <limits>
 #include <openscenario_interpreter/error.hpp>
 #include <openscenario_interpreter/syntax/double.hpp>
-#include <regex>
+#include <system_error>
 
 namespace openscenario_interpreter
 {
@@ -82,13 +83,13 @@ auto operator>>(std::istream & is, Double & datum) -> std::istream &
 
   is >> token;
 
-  static const std::regex infinity{R"([+-]?INF)"};
-
-  std::smatch result;
-
-  if (std::regex_match(token, result, infinity)) {
-    datum.data = (result.str(1) == "-" ? -1 : 1) * std::numeric_limits<Double::value_type>::max();
-  } else {
+  if (token == "INF" or token == "+INF") {
+    datum.data = std::numeric_limits<Double::value_type>::max();
+  } else if (token == "-INF") {
+    datum.data = std::numeric_limits<Double::value_type>::lowest();
+  } else if (const auto [end, error] =
+               std::from_chars(token.data(), token.data() + token.size(), datum.data);
+             error != std::errc() or end != token.data() + token.size()) {
     datum.data = boost::lexical_cast<Double::value_type>(token);
   }
 
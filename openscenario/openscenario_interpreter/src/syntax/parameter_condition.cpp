@@ -63,7 +63,7 @@ auto ParameterCondition::description() const -> String
   std::stringstream description;
 
   description << "The value of parameter " << std::quoted(parameter_ref) << " = "
-              << local().ref(parameter_ref) << " " << rule << " " << value << "?";
+              << resolve() << " " << rule << " " << value << "?";
 
   return description.str();
 }
@@ -71,8 +71,7 @@ auto ParameterCondition::description() const -> String
 auto ParameterCondition::evaluate() const -> Object
 {
   try {
-    const auto parameter = local().ref(parameter_ref);
-    if (not parameter) {
+    if (const auto & parameter = resolve(); not parameter) {
       THROW_SYNTAX_ERROR(parameter_ref, " cannot be found from this scope");
     } else {
       return asBoolean(compare(parameter, rule, value));
@@ -81,5 +80,15 @@ auto ParameterCondition::evaluate() const -> Object
     throw SemanticError("No such parameter ", std::quoted(parameter_ref));
   }
 }
+
+auto ParameterCondition::resolve() const -> const Object &
+{
+  /*
+     NOTE: ParameterSetAction and ParameterModifyAction update the value of a
+     parameter in place, so the object found here remains the parameter's
+     object for the rest of the simulation.
+  */
+  return parameter ? parameter : parameter = local().ref(parameter_ref);
+}
 }  // namespace syntax
 }  // namespace openscenario_interpreter
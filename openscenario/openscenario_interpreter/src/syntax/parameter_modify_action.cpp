@@ -34,7 +34,7 @@ auto ParameterModifyAction::run() noexcept -> void {}
 auto ParameterModifyAction::start() const -> void
 {
   try {
-    const auto target = local().ref(parameter_ref);
+    const auto & target = parameter ? parameter : parameter = local().ref(parameter_ref);
     if (rule.is<ParameterAddValueRule>()) {
       rule.as<ParameterAddValueRule>()(target);
     } else {
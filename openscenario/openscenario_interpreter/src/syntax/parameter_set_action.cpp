@@ -36,6 +36,11 @@ auto ParameterSetAction::run() noexcept -> void {}
 
 auto ParameterSetAction::set(
   const Scope & scope, const String & parameter_ref, const String & value) -> void
+{
+  set(scope.ref(parameter_ref), value);
+}
+
+auto ParameterSetAction::set(const Object & parameter, const String & value) -> void
 {
   static const std::unordered_map<
     std::type_index, std::function<void(const Object &, const String &)>>
@@ -50,14 +55,12 @@ auto ParameterSetAction::set(
       // clang-format on
     };
 
-  const auto parameter = scope.ref(parameter_ref);
-
   overloads.at(parameter.type())(parameter, value);
 }
 
 auto ParameterSetAction::start() const -> void  //
 {
-  set(local(), parameter_ref, value);
+  set(parameter ? parameter : parameter = local().ref(parameter_ref), value);
 }
 }  // namespace syntax
 }  // namespace openscenario_interpreter
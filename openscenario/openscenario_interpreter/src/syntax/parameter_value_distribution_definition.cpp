@@ -21,8 +21,7 @@ inline namespace syntax
 {
 ParameterValueDistributionDefinition::ParameterValueDistributionDefinition(
   const pugi::xml_node & node, Scope & scope)
-: ParameterValueDistribution(
-    readElement<ParameterValueDistribution>("parameterValueDistribution", node, scope))
+: ParameterValueDistribution(node, scope)
 {
 }
 }  // namespace syntax
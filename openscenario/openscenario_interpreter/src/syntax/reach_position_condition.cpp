@@ -12,13 +12,13 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <openscenario_interpreter/parameter_store.hpp>
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/reader/element.hpp>
 #include <openscenario_interpreter/simulator_core.hpp>
 #include <openscenario_interpreter/syntax/reach_position_condition.hpp>
 #include <openscenario_interpreter/utility/overload.hpp>
 #include <openscenario_interpreter/utility/print.hpp>
-#include <rclcpp/rclcpp.hpp>
 #include <traffic_simulator/helper/helper.hpp>
 
 namespace openscenario_interpreter
@@ -32,11 +32,7 @@ ReachPositionCondition::ReachPositionCondition(
   compare(Rule::lessThan),
   triggering_entities(triggering_entities),
   results(triggering_entities.entity_refs.size(), Double::nan()),
-  consider_z([]() {
-    rclcpp::Node node{"get_parameter", "simulation"};
-    node.declare_parameter("consider_pose_by_road_slope", false);
-    return node.get_parameter("consider_pose_by_road_slope").as_bool();
-  }())
+  consider_z(ParameterStore::get("consider_pose_by_road_slope", false))
 {
 }
 
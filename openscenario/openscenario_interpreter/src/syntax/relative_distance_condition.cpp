@@ -12,6 +12,7 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <openscenario_interpreter/parameter_store.hpp>
 #include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/syntax/entities.hpp>  // TEMPORARY (TODO REMOVE THIS LINE)
 #include <openscenario_interpreter/syntax/relative_distance_condition.hpp>
@@ -39,11 +40,7 @@ RelativeDistanceCondition::RelativeDistanceCondition(
   value(readAttribute<Double>("value", node, scope)),
   triggering_entities(triggering_entities),
   results(triggering_entities.entity_refs.size(), Double::nan()),
-  consider_z([]() {
-    rclcpp::Node node{"get_parameter", "simulation"};
-    node.declare_parameter("consider_pose_by_road_slope", false);
-    return node.get_parameter("consider_pose_by_road_slope").as_bool();
-  }())
+  consider_z(ParameterStore::get("consider_pose_by_road_slope", false))
 {
 }
 
@@ -43,11 +43,11 @@ StoryboardElementStateCondition::StoryboardElementStateCondition(
   */
 
   auto register_callback = [this]() {
-    local()
-      .ref<StoryboardElement>(storyboard_element_ref)
-      .addTransitionCallback(state, [this](auto && storyboard_element) {
-        current_state = storyboard_element.state().template as<StoryboardElementState>();
-      });
+    auto & target = local().ref<StoryboardElement>(storyboard_element_ref);
+    target.addTransitionCallback(state, [this](auto && storyboard_element) {
+      current_state = storyboard_element.state().template as<StoryboardElementState>();
+    });
+    storyboard_element = &target;
   };
 
   Storyboard::thunks.push(register_callback);
@@ -66,16 +66,16 @@ auto StoryboardElementStateCondition::description() const -> String
 auto StoryboardElementStateCondition::evaluate() -> Object
 {
   auto update = [this]() {
-    auto storyboard_element = [this]() {
-      return local().ref<StoryboardElement>(storyboard_element_ref);
-    };
-    return current_state = storyboard_element().state().template as<StoryboardElementState>();
+    if (not storyboard_element) {
+      storyboard_element = &local().ref<StoryboardElement>(storyboard_element_ref);
+    }
+    return current_state = storyboard_element->state().template as<StoryboardElementState>();
   };
 
   /*
      Note that current_state may have been updated by a callback function set
      in the constructor (before this member function was called).  And at this
-     point local().ref<StoryboardElement>(storyboard_element_ref).state() may
+     point storyboard_element->state() may
      have transitioned to a different state than the one recorded in
      current_state.
 
@@ -36,7 +36,11 @@ auto TrafficSignalControllerAction::run() noexcept -> void {}
 
 auto TrafficSignalControllerAction::start() -> void
 {
-  local().ref<TrafficSignalController>(traffic_signal_controller_ref).changePhaseTo(phase);
+  if (not traffic_signal_controller) {
+    traffic_signal_controller =
+      &local().ref<TrafficSignalController>(traffic_signal_controller_ref);
+  }
+  traffic_signal_controller->changePhaseTo(phase);
 }
 }  // namespace syntax
 }  // namespace openscenario_interpreter
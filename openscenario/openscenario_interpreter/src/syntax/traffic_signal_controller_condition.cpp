@@ -42,9 +42,11 @@ auto TrafficSignalControllerCondition::description() const -> String
 
 auto TrafficSignalControllerCondition::evaluate() -> Object
 {
-  const auto & controller = scope.ref<TrafficSignalController>(traffic_signal_controller_ref);
-  current_phase_name = controller.currentPhaseName();
-  current_phase_since = controller.currentPhaseSince();
+  if (not traffic_signal_controller) {
+    traffic_signal_controller = &scope.ref<TrafficSignalController>(traffic_signal_controller_ref);
+  }
+  current_phase_name = traffic_signal_controller->currentPhaseName();
+  current_phase_since = traffic_signal_controller->currentPhaseSince();
   return asBoolean(current_phase_name == phase);
 }
 }  // namespace syntax
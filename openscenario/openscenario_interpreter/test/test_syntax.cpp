@@ -16,14 +16,98 @@
 
 #include <ament_index_cpp/get_package_share_directory.hpp>
 #include <chrono>
+#include <cmath>
 #include <cstdlib>
+#include <limits>
 #include <memory>
+#include <openscenario_interpreter/reader/attribute.hpp>
 #include <openscenario_interpreter/syntax/open_scenario.hpp>
+#include <pugixml.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <regex>
+#include <string>
 #include <thread>
 
 TEST(syntax, dummy) { ASSERT_TRUE(true); }
 
+namespace
+{
+template <typename T>
+auto readValue(const std::string & value) -> T
+{
+  pugi::xml_document document;
+  document.append_child("Test").append_attribute("value").set_value(value.c_str());
+  const auto scope = openscenario_interpreter::Scope(nullptr);
+  return openscenario_interpreter::readAttribute<T>("value", document.child("Test"), scope);
+}
+}  // namespace
+
+TEST(syntax, readDoubleAttribute)
+{
+  using openscenario_interpreter::Double;
+  EXPECT_EQ(readValue<Double>("1.5").data, 1.5);
+  EXPECT_EQ(readValue<Double>("-0.25").data, -0.25);
+  EXPECT_EQ(readValue<Double>("+2.5").data, 2.5);
+  EXPECT_EQ(readValue<Double>("1e3").data, 1000);
+  EXPECT_EQ(readValue<Double>("INF").data, std::numeric_limits<double>::max());
+  EXPECT_EQ(readValue<Double>("+INF").data, std::numeric_limits<double>::max());
+  EXPECT_EQ(readValue<Double>("-INF").data, std::numeric_limits<double>::lowest());
+  EXPECT_TRUE(std::isnan(readValue<Double>("nan").data));
+  EXPECT_THROW(readValue<Double>("0x10"), openscenario_interpreter::SyntaxError);
+  EXPECT_THROW(readValue<Double>("1.5m"), openscenario_interpreter::SyntaxError);
+}
+
+TEST(syntax, readIntegerAttribute)
+{
+  using openscenario_interpreter::Integer;
+  using openscenario_interpreter::UnsignedInteger;
+  EXPECT_EQ(readValue<Integer>("42").data, 42);
+  EXPECT_EQ(readValue<Integer>("-42").data, -42);
+  EXPECT_EQ(readValue<Integer>("+42").data, 42);
+  EXPECT_EQ(readValue<UnsignedInteger>("42").data, 42u);
+  EXPECT_THROW(readValue<Integer>("0x10"), openscenario_interpreter::SyntaxError);
+  EXPECT_THROW(readValue<Integer>("42abc"), openscenario_interpreter::SyntaxError);
+  EXPECT_THROW(readValue<Integer>("4.2"), openscenario_interpreter::SyntaxError);
+}
+
+TEST(syntax, findSubstitutionMatchesRegex)
+{
+  // NOTE: The regular expression findSubstitution replaced
+  static const auto pattern = std::regex(R"((.*)\$\((([\w-]+)\s?([^\)]*))\)(.*))");
+
+  for (const std::string s : {
+         "",
+         "no substitution",
+         "$(find-pkg-share foo)",
+         "$(find-pkg-share foo)/bar/baz.xosc",
+         "prefix/$(var name)/suffix",
+         "$(dirname)",
+         "$(var a) and $(var b)",
+         "$(find-pkg-share $(var package))/map",
+         "$(var  two spaces)",
+         "$(var\ttab)",
+         "$(var unterminated",
+         "$()",
+         "$( leading space)",
+         "$(foo(bar)",
+         "$(a.b c)",
+         "$$(var x))",
+         "$(var x)$(",
+       }) {
+    std::smatch result;
+    const auto substitution = openscenario_interpreter::findSubstitution(s);
+    if (std::regex_match(s, result, pattern)) {
+      ASSERT_TRUE(substitution) << s;
+      EXPECT_EQ(substitution->begin, result.length(1)) << s;
+      EXPECT_EQ(substitution->end, s.size() - result.length(5)) << s;
+      EXPECT_EQ(substitution->name, result.str(3)) << s;
+      EXPECT_EQ(substitution->arguments, result.str(4)) << s;
+    } else {
+      EXPECT_FALSE(substitution) << s;
+    }
+  }
+}
+
 // TEST(Syntax, LexicalScope)
 // {
 //   using ament_index_cpp::get_package_share_directory;
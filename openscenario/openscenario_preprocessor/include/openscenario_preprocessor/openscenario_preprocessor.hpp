@@ -15,14 +15,25 @@
 #ifndef OPENSCENARIO_PREPROCESSOR__OPENSCENARIO_PREPROCESSOR_HPP_
 #define OPENSCENARIO_PREPROCESSOR__OPENSCENARIO_PREPROCESSOR_HPP_
 
-#include <concealer/execute.hpp>
+#include <condition_variable>
+#include <cstddef>
 #include <deque>
+#include <functional>
 #include <memory>
+#include <mutex>
 #include <openscenario_interpreter/syntax/open_scenario.hpp>
+#include <openscenario_preprocessor/parameter_distribution.hpp>
+#include <openscenario_preprocessor/schema_validator.hpp>
 #include <openscenario_preprocessor_msgs/srv/check_derivative_remained.hpp>
 #include <openscenario_preprocessor_msgs/srv/derive.hpp>
 #include <openscenario_preprocessor_msgs/srv/load.hpp>
+#include <optional>
 #include <rclcpp/rclcpp.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+#include <string>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace openscenario_preprocessor
 {
@@ -49,16 +60,95 @@ struct ScenarioSet
   float frame_rate;
 };
 
+/*
+   Scenarios waiting to be handed out by the derive service. Only the number of
+   scenarios, the index of the next one and the results of the scenarios being
+   derived ahead of it are held, so a derivation of millions of scenarios takes
+   constant memory and the load service does not wait for any of them.
+*/
+struct Derivation
+{
+  ScenarioSet scenario;
+
+  std::size_t size = 1;
+
+  std::function<std::string(std::size_t)> derive = nullptr;  // NOTE: null for a plain scenario
+
+  std::size_t index = 0;
+
+  struct Derived
+  {
+    bool is_done = false;
+
+    std::string path;
+
+    std::optional<std::string> error;  // NOTE: nullopt if derived successfully
+  };
+
+  /*
+     Results of the scenarios claimed to be derived, from the one of `index`.
+  */
+  std::deque<Derived> derived;
+
+  auto empty() const noexcept { return size <= index; }
+
+  auto claimable(std::size_t window) const noexcept
+  {
+    return derive and index + derived.size() < size and derived.size() < window;
+  }
+
+  auto claim() -> std::size_t
+  {
+    derived.emplace_back();
+    return index + derived.size() - 1;
+  }
+
+  auto complete(std::size_t i, Derived && result) -> void
+  {
+    result.is_done = true;
+    derived[i - index] = std::move(result);
+  }
+
+  auto ready() const noexcept
+  {
+    return not derive or (not derived.empty() and derived.front().is_done);
+  }
+
+  auto pop() -> ScenarioSet  // NOTE: The scenario is skipped even if failed to be derived.
+  {
+    auto result = scenario;
+    ++index;
+    if (derive) {
+      auto derived_scenario = std::move(derived.front());
+      derived.pop_front();
+      if (derived_scenario.error) {
+        throw common::Error(*derived_scenario.error);
+      } else {
+        result.path = derived_scenario.path;
+      }
+    }
+    return result;
+  }
+};
+
 class Preprocessor : public rclcpp::Node
 {
 public:
   explicit Preprocessor(const rclcpp::NodeOptions &);
 
+  ~Preprocessor() override;
+
 private:
   void preprocessScenario(ScenarioSet &);
 
+  void derive(const ScenarioSet &, const boost::filesystem::path &, const ParameterDistribution &);
+
   [[nodiscard]] bool validateXOSC(const boost::filesystem::path &, bool);
 
+  SchemaValidator validate;
+
+  const std::string output_directory;
+
   rclcpp::Service<openscenario_preprocessor_msgs::srv::Load>::SharedPtr load_server;
 
   rclcpp::Service<openscenario_preprocessor_msgs::srv::Derive>::SharedPtr derive_server;
@@ -66,9 +156,24 @@ private:
   rclcpp::Service<openscenario_preprocessor_msgs::srv::CheckDerivativeRemained>::SharedPtr
     check_server;
 
-  std::deque<ScenarioSet> preprocessed_scenarios;
+  std::deque<std::shared_ptr<Derivation>> preprocessed_scenarios;
 
   std::mutex preprocessed_scenarios_mutex;
+
+  /*
+     Notified when a scenario is claimed, derived or handed out.
+  */
+  std::condition_variable preprocessed_scenarios_condition;
+
+  bool is_stop_requested = false;
+
+  /*
+     Threads deriving the scenarios of the first derivation ahead of the derive
+     service, up to `derivation_window` of them.
+  */
+  std::vector<std::thread> derivers;
+
+  const std::size_t derivation_window;
 };
 }  // namespace openscenario_preprocessor
 
@@ -0,0 +1,76 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENSCENARIO_PREPROCESSOR__PARAMETER_DISTRIBUTION_HPP_
+#define OPENSCENARIO_PREPROCESSOR__PARAMETER_DISTRIBUTION_HPP_
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <openscenario_interpreter/syntax/parameter_value_distribution.hpp>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace openscenario_preprocessor
+{
+using ParameterSet = std::vector<std::pair<std::string, std::string>>;
+
+/* ---- ParameterDistribution --------------------------------------------------
+ *
+ *  Random access view of the parameter sets described by a
+ *  ParameterValueDistribution.
+ *
+ *  Deterministic distributions are the Cartesian product of their
+ *  DistributionSet, DistributionRange and ValueSetDistribution axes. The i-th
+ *  parameter set is decoded from i as a mixed radix number, so no combination
+ *  is ever materialized.
+ *
+ *  Stochastic distributions draw the i-th parameter set from a random engine
+ *  seeded with the pair (randomSeed, i), so each parameter set can be
+ *  computed independently of (and concurrently with) the others while the
+ *  whole sequence stays reproducible for a given randomSeed.
+ *
+ *  The view copies everything it needs out of the syntax tree, and operator[]
+ *  is thread-safe.
+ *
+ * -------------------------------------------------------------------------- */
+class ParameterDistribution
+{
+  struct Axis
+  {
+    std::size_t size;
+
+    std::function<void(std::size_t, ParameterSet &)> assign;
+  };
+
+  std::vector<Axis> axes;
+
+  std::size_t number_of_test_runs = 0;
+
+  std::uint64_t random_seed = 0;
+
+  std::function<void(std::mt19937_64 &, ParameterSet &)> sample;
+
+public:
+  explicit ParameterDistribution(const openscenario_interpreter::ParameterValueDistribution &);
+
+  auto size() const -> std::size_t;
+
+  auto operator[](std::size_t) const -> ParameterSet;
+};
+}  // namespace openscenario_preprocessor
+
+#endif  // OPENSCENARIO_PREPROCESSOR__PARAMETER_DISTRIBUTION_HPP_
@@ -0,0 +1,69 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef OPENSCENARIO_PREPROCESSOR__SCHEMA_VALIDATOR_HPP_
+#define OPENSCENARIO_PREPROCESSOR__SCHEMA_VALIDATOR_HPP_
+
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <xercesc/framework/XMLGrammarPool.hpp>
+#include <xercesc/sax2/SAX2XMLReader.hpp>
+
+namespace openscenario_preprocessor
+{
+/* ---- SchemaValidator --------------------------------------------------------
+ *
+ *  Validates OpenSCENARIO files against an XML Schema (e.g.
+ *  OpenSCENARIO-1.2.xsd of package openscenario_utility) in-process.
+ *
+ *  The schema is parsed into a Xerces-C grammar pool only once, when the
+ *  validator is constructed, and every file is validated against that cached
+ *  grammar. The result of each validation is memoized by the hash of the file
+ *  content, so validating the same content twice (e.g. the base scenario of
+ *  each ParameterValueDistribution) costs only a file read.
+ *
+ *  This class is not thread-safe.
+ *
+ * -------------------------------------------------------------------------- */
+class SchemaValidator
+{
+  struct Initialization
+  {
+    Initialization();
+
+    ~Initialization();
+  } initialization;  // NOTE: must be initialized before (and destroyed after) the following
+
+  std::unique_ptr<xercesc::XMLGrammarPool> grammar_pool;
+
+  std::unique_ptr<xercesc::SAX2XMLReader> reader;
+
+  std::unordered_map<std::size_t, std::pair<bool, std::string>> results;
+
+public:
+  explicit SchemaValidator(const boost::filesystem::path & schema);
+
+  /*
+     Returns whether the given file is valid, and the validation errors if it
+     is not.
+  */
+  auto operator()(const boost::filesystem::path &) -> const std::pair<bool, std::string> &;
+};
+}  // namespace openscenario_preprocessor
+
+#endif  // OPENSCENARIO_PREPROCESSOR__SCHEMA_VALIDATOR_HPP_
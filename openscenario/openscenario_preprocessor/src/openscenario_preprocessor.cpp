@@ -13,15 +13,23 @@
 // limitations under the License.
 
 #include <algorithm>
+#include <ament_index_cpp/get_package_prefix.hpp>
+#include <memory>
 #include <openscenario_interpreter/syntax/open_scenario.hpp>
 #include <openscenario_interpreter/syntax/parameter_value_distribution.hpp>
 #include <openscenario_preprocessor/openscenario_preprocessor.hpp>
+#include <pugixml.hpp>
 #include <rclcpp_components/register_node_macro.hpp>
 
 namespace openscenario_preprocessor
 {
 Preprocessor::Preprocessor(const rclcpp::NodeOptions & options)
 : rclcpp::Node("openscenario_preprocessor", options),
+  validate(
+    ament_index_cpp::get_package_prefix("openscenario_utility") +
+    "/lib/openscenario_utility/resources/OpenSCENARIO-1.2.xsd"),
+  output_directory(
+    declare_parameter<std::string>("output_directory", "/tmp/openscenario_preprocessor")),
   load_server(create_service<openscenario_preprocessor_msgs::srv::Load>(
     "~/load",
     [this](
@@ -44,12 +52,33 @@ Preprocessor::Preprocessor(const rclcpp::NodeOptions & options)
     [this](
       const openscenario_preprocessor_msgs::srv::Derive::Request::SharedPtr,
       openscenario_preprocessor_msgs::srv::Derive::Response::SharedPtr response) -> void {
-      auto lock = std::lock_guard(preprocessed_scenarios_mutex);
-      if (preprocessed_scenarios.empty()) {
-        response->path = "no output";
-      } else {
-        *response = preprocessed_scenarios.front().getDeriveResponse();
-        preprocessed_scenarios.pop_front();
+      auto lock = std::unique_lock(preprocessed_scenarios_mutex);
+      /*
+         A scenario that fails to be derived is reported and skipped, and the
+         next one is handed out instead, so "no output" always means that no
+         scenario remains.
+      */
+      for (response->path = "no output"; not preprocessed_scenarios.empty();) {
+        auto derivation = preprocessed_scenarios.front();
+        preprocessed_scenarios_condition.wait(lock, [&]() {
+          return derivation->ready() or preprocessed_scenarios.empty() or
+                 preprocessed_scenarios.front() != derivation;
+        });
+        if (preprocessed_scenarios.empty() or preprocessed_scenarios.front() != derivation) {
+          continue;
+        }
+        try {
+          *response = derivation->pop().getDeriveResponse();
+        } catch (const std::exception & error) {
+          RCLCPP_ERROR_STREAM(get_logger(), error.what());
+        }
+        if (derivation->empty()) {
+          preprocessed_scenarios.pop_front();
+        }
+        preprocessed_scenarios_condition.notify_all();
+        if (response->path != "no output") {
+          return;
+        }
       }
     })),
   check_server(create_service<openscenario_preprocessor_msgs::srv::CheckDerivativeRemained>(
@@ -60,18 +89,67 @@ Preprocessor::Preprocessor(const rclcpp::NodeOptions & options)
       -> void {
       auto lock = std::lock_guard(preprocessed_scenarios_mutex);
       response->derivative_remained = not preprocessed_scenarios.empty();
-    }))
+    })),
+  derivation_window(2 * std::max(1u, std::thread::hardware_concurrency()))
+{
+  /*
+     Each deriver claims the next scenario of the first derivation not claimed
+     yet, derives it and writes it to disk without holding the lock, so that
+     scenarios are derived concurrently while no more than `derivation_window`
+     of them are ahead of the derive service.
+  */
+  for (auto i = 0u; i < std::max(1u, std::thread::hardware_concurrency()); ++i) {
+    derivers.emplace_back([this]() {
+      for (auto lock = std::unique_lock(preprocessed_scenarios_mutex);;) {
+        preprocessed_scenarios_condition.wait(lock, [this]() {
+          return is_stop_requested or
+                 (not preprocessed_scenarios.empty() and
+                  preprocessed_scenarios.front()->claimable(derivation_window));
+        });
+        if (is_stop_requested) {
+          return;
+        } else {
+          auto derivation = preprocessed_scenarios.front();
+          auto index = derivation->claim();
+          lock.unlock();
+          auto derived = Derivation::Derived();
+          try {
+            derived.path = derivation->derive(index);
+          } catch (const std::exception & error) {
+            derived.error = error.what();
+          }
+          lock.lock();
+          derivation->complete(index, std::move(derived));
+          preprocessed_scenarios_condition.notify_all();
+        }
+      }
+    });
+  }
+}
+
+Preprocessor::~Preprocessor()
 {
+  {
+    auto lock = std::lock_guard(preprocessed_scenarios_mutex);
+    is_stop_requested = true;
+  }
+
+  preprocessed_scenarios_condition.notify_all();
+
+  for (auto && deriver : derivers) {
+    deriver.join();
+  }
 }
 
 bool Preprocessor::validateXOSC(const boost::filesystem::path & file_name, bool verbose = false)
 {
-  auto result =
-    concealer::dollar("ros2 run openscenario_utility validation.py " + file_name.string());
-  if (verbose) {
-    std::cout << "validate : " << result << std::endl;
+  const auto & [valid, errors] = validate(file_name);
+  if (not valid) {
+    std::cout << "[NG] " << file_name.string() << "\n\n" << errors << std::flush;
+  } else if (verbose) {
+    std::cout << "[OK] " << file_name.string() << std::endl;
   }
-  return result.find("All xosc files given are standard compliant.") != std::string::npos;
+  return valid;
 }
 
 void Preprocessor::preprocessScenario(ScenarioSet & scenario)
@@ -88,11 +166,9 @@ void Preprocessor::preprocessScenario(ScenarioSet & scenario)
       std::cout << "base_scenario_path : " << base_scenario_path << std::endl;
       if (boost::filesystem::exists(base_scenario_path)) {
         if (validateXOSC(base_scenario_path, true)) {
-          // TODO : implement in feature/parameter_value_distribution branch
-          //
-          //  parameters = evaluate( parameter_value_distribution( given scenario ) )
-          //  for( auto derived_scenario : embedParameter( linked scenario, parameters)
-          //    preprocessed_scenarios.emplace_back({derived_scenario, derive_server});
+          derive(
+            scenario, base_scenario_path,
+            ParameterDistribution(script->category.as<ParameterValueDistribution>()));
         } else {
           throw common::Error("base scenario is not valid : " + base_scenario_path.string());
         }
@@ -103,12 +179,70 @@ void Preprocessor::preprocessScenario(ScenarioSet & scenario)
 
     } else {
       // normal scenario
-      preprocessed_scenarios.emplace_back(scenario);
+      preprocessed_scenarios.push_back(std::make_shared<Derivation>(Derivation{scenario}));
     }
   } else {
     throw common::Error("the scenario file is not valid. Please check your scenario");
   }
 }
+
+void Preprocessor::derive(
+  const ScenarioSet & scenario, const boost::filesystem::path & base_scenario_path,
+  const ParameterDistribution & distribution)
+{
+  auto base_scenario = std::make_shared<pugi::xml_document>();
+
+  if (not base_scenario->load_file(base_scenario_path.c_str())) {
+    throw common::Error("failed to load base scenario : " + base_scenario_path.string());
+  }
+
+  if (distribution.size() == 0) {
+    return;  // NOTE: e.g. a Stochastic distribution with numberOfTestRuns="0"
+  }
+
+  /*
+     Every parameter set of a distribution assigns the same parameters, so the
+     declarations are checked once here, and the load service (rather than the
+     derive service, for each scenario) reports a parameter that is not
+     declared.
+  */
+  for (auto && [name, value] : distribution[0]) {
+    if (not base_scenario->child("OpenSCENARIO")
+              .child("ParameterDeclarations")
+              .find_child_by_attribute("ParameterDeclaration", "name", name.c_str())) {
+      throw common::Error(
+        "parameter " + name + " is not declared in " + base_scenario_path.string());
+    }
+  }
+
+  const auto directory = boost::filesystem::path(output_directory) / base_scenario_path.stem();
+
+  boost::filesystem::create_directories(directory);
+
+  auto derive_scenario = [base_scenario, distribution, directory,
+                          stem = base_scenario_path.stem().string()](std::size_t index) {
+    pugi::xml_document derived_scenario;
+    derived_scenario.reset(*base_scenario);
+    auto parameter_declarations =
+      derived_scenario.child("OpenSCENARIO").child("ParameterDeclarations");
+    for (auto && [name, value] : distribution[index]) {
+      parameter_declarations
+        .find_child_by_attribute("ParameterDeclaration", "name", name.c_str())
+        .attribute("value")
+        .set_value(value.c_str());
+    }
+    const auto path = (directory / (stem + "." + std::to_string(index) + ".xosc")).string();
+    if (not derived_scenario.save_file(path.c_str())) {
+      throw common::Error("failed to write derived scenario : " + path);
+    }
+    return path;
+  };
+
+  preprocessed_scenarios.push_back(
+    std::make_shared<Derivation>(Derivation{scenario, distribution.size(), derive_scenario}));
+
+  preprocessed_scenarios_condition.notify_all();
+}
 }  // namespace openscenario_preprocessor
 
 RCLCPP_COMPONENTS_REGISTER_NODE(openscenario_preprocessor::Preprocessor)
@@ -0,0 +1,274 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <iomanip>
+#include <limits>
+#include <openscenario_interpreter/syntax/deterministic.hpp>
+#include <openscenario_interpreter/syntax/deterministic_multi_parameter_distribution.hpp>
+#include <openscenario_interpreter/syntax/deterministic_single_parameter_distribution.hpp>
+#include <openscenario_interpreter/syntax/distribution_range.hpp>
+#include <openscenario_interpreter/syntax/distribution_set.hpp>
+#include <openscenario_interpreter/syntax/histogram.hpp>
+#include <openscenario_interpreter/syntax/histogram_bin.hpp>
+#include <openscenario_interpreter/syntax/normal_distribution.hpp>
+#include <openscenario_interpreter/syntax/poisson_distribution.hpp>
+#include <openscenario_interpreter/syntax/probability_distribution_set.hpp>
+#include <openscenario_interpreter/syntax/stochastic.hpp>
+#include <openscenario_interpreter/syntax/uniform_distribution.hpp>
+#include <openscenario_interpreter/syntax/user_defined_distribution.hpp>
+#include <openscenario_preprocessor/parameter_distribution.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+#include <sstream>
+
+namespace openscenario_preprocessor
+{
+namespace
+{
+auto format(double value) -> std::string
+{
+  std::stringstream ss;
+  ss << std::setprecision(std::numeric_limits<double>::digits10) << value;
+  return ss.str();
+}
+
+/*
+   Converts randomSeed, which is a Double, to the seed of the random engine.
+   The fractional part is discarded and the integral part is reduced modulo
+   2^64, so that any finite randomSeed gives a seed without overflowing the
+   conversion.
+*/
+auto toRandomSeed(double random_seed) -> std::uint64_t
+{
+  if (not std::isfinite(random_seed)) {
+    throw common::Error("randomSeed of Stochastic must be finite, but ", random_seed, " given");
+  } else {
+    // NOTE: The remainder is less than 2^64 and so is exactly convertible.
+    const auto magnitude =
+      static_cast<std::uint64_t>(std::fmod(std::trunc(std::abs(random_seed)), 0x1p64));
+    return random_seed < 0 ? -magnitude : magnitude;
+  }
+}
+
+/*
+   Draws a value within the given range (if it is a valid range) by rejection
+   sampling. If the distribution has (almost) no mass in the range, the last
+   drawn value is clamped instead of looping forever.
+*/
+template <typename Draw>
+auto drawWithin(const openscenario_interpreter::Range & range, std::mt19937_64 & engine, Draw draw)
+  -> double
+{
+  if (const auto lower = range.lower_limit.data, upper = range.upper_limit.data; lower <= upper) {
+    auto value = draw(engine);
+    for (auto retry = 0; retry < 1000 and (value < lower or upper < value); ++retry) {
+      value = draw(engine);
+    }
+    return std::clamp<double>(value, lower, upper);
+  } else {
+    return draw(engine);
+  }
+}
+}  // namespace
+
+ParameterDistribution::ParameterDistribution(
+  const openscenario_interpreter::ParameterValueDistribution & distribution)
+{
+  using namespace openscenario_interpreter;
+
+  if (distribution.is<Deterministic>()) {
+    for (auto && each : distribution.as<Deterministic>().deterministic_parameter_distributions) {
+      if (each.is<DeterministicSingleParameterDistribution>()) {
+        const auto & single = each.as<DeterministicSingleParameterDistribution>();
+        if (single.is<DistributionSet>()) {
+          std::vector<std::string> values;
+          for (auto && element : single.as<DistributionSet>().elements) {
+            values.push_back(element.value);
+          }
+          axes.push_back(
+            {values.size(), [name = single.parameter_name, values](auto i, auto & set) {
+               set.emplace_back(name, values[i]);
+             }});
+        } else if (single.is<DistributionRange>()) {
+          const auto & distribution_range = single.as<DistributionRange>();
+          const auto lower = distribution_range.range.lower_limit.data;
+          const auto upper = distribution_range.range.upper_limit.data;
+          const auto step = distribution_range.step_width.data;
+          if (not(0 < step) or not(lower <= upper)) {
+            throw common::Error(
+              "DistributionRange of parameter ", std::quoted(single.parameter_name),
+              " must have a positive stepWidth and lowerLimit <= upperLimit");
+          }
+          axes.push_back(
+            {static_cast<std::size_t>(std::floor((upper - lower) / step + 1e-9)) + 1,
+             [name = single.parameter_name, lower, step](auto i, auto & set) {
+               set.emplace_back(name, format(lower + static_cast<double>(i) * step));
+             }});
+        } else {
+          throw common::Error(
+            "UserDefinedDistribution of parameter ", std::quoted(single.parameter_name),
+            " is not supported");
+        }
+      } else {
+        const auto & multi = each.as<DeterministicMultiParameterDistribution>();
+        std::vector<ParameterSet> sets;
+        for (auto && value_set : multi.parameter_value_sets) {
+          auto & set = sets.emplace_back();
+          for (auto && assignment : value_set.parameter_assignments) {
+            set.emplace_back(assignment.parameterRef, assignment.value);
+          }
+        }
+        axes.push_back({sets.size(), [sets](auto i, auto & set) {
+                          set.insert(std::end(set), std::begin(sets[i]), std::end(sets[i]));
+                        }});
+      }
+    }
+
+    std::size_t size = 1;
+    for (auto && axis : axes) {
+      if (axis.size == 0 or std::numeric_limits<std::size_t>::max() / axis.size < size) {
+        throw common::Error("Deterministic distribution has no or too many combinations");
+      } else {
+        size *= axis.size;
+      }
+    }
+  } else if (distribution.is<Stochastic>()) {
+    const auto & stochastic = distribution.as<Stochastic>();
+
+    number_of_test_runs = stochastic.number_of_test_runs;
+
+    random_seed = toRandomSeed(stochastic.random_seed.data);
+
+    const auto & stochastic_distribution = stochastic.stochastic_distribution;
+
+    auto draw = [&]() -> std::function<std::string(std::mt19937_64 &)> {
+      if (stochastic_distribution.is<NormalDistribution>()) {
+        const auto & normal = stochastic_distribution.as<NormalDistribution>();
+        return [range = normal.range, mean = normal.expected_value.data,
+                deviation = std::sqrt(normal.variance.data)](auto & engine) {
+          return format(drawWithin(range, engine, [&](auto & random_engine) {
+            return std::normal_distribution<double>(mean, deviation)(random_engine);
+          }));
+        };
+      } else if (stochastic_distribution.is<UniformDistribution>()) {
+        const auto & uniform = stochastic_distribution.as<UniformDistribution>();
+        return [lower = uniform.range.lower_limit.data,
+                upper = uniform.range.upper_limit.data](auto & engine) {
+          return format(std::uniform_real_distribution<double>(lower, upper)(engine));
+        };
+      } else if (stochastic_distribution.is<PoissonDistribution>()) {
+        const auto & poisson = stochastic_distribution.as<PoissonDistribution>();
+        return [range = poisson.range, mean = poisson.expected_value.data](auto & engine) {
+          return std::to_string(std::lround(drawWithin(range, engine, [&](auto & random_engine) {
+            return static_cast<double>(std::poisson_distribution<long>(mean)(random_engine));
+          })));
+        };
+      } else if (stochastic_distribution.is<Histogram>()) {
+        /*
+           NOTE: The bins may be given in any order and may leave gaps between
+           each other, so they are sorted by their lower limits and each gap
+           becomes an interval of zero density. The density of a bin is its
+           weight divided by its width, so that a bin is drawn from with a
+           probability proportional to its weight.
+        */
+        std::vector<std::reference_wrapper<const HistogramBin>> bins;
+        for (auto && bin : stochastic_distribution.as<Histogram>().bins) {
+          bins.emplace_back(bin);
+        }
+        std::sort(std::begin(bins), std::end(bins), [](const auto & a, const auto & b) {
+          return a.get().range.lower_limit.data < b.get().range.lower_limit.data;
+        });
+        std::vector<double> intervals, densities;
+        for (const HistogramBin & bin : bins) {
+          const auto lower = bin.range.lower_limit.data;
+          const auto upper = bin.range.upper_limit.data;
+          if (not(lower < upper) or not(0 <= bin.weight.data) or
+              (not intervals.empty() and lower < intervals.back())) {
+            throw common::Error(
+              "Histogram of parameter ", std::quoted(stochastic_distribution.parameter_name),
+              " must have non-overlapping bins with lowerLimit < upperLimit and non-negative "
+              "weights");
+          } else if (intervals.empty()) {
+            intervals.push_back(lower);
+          } else if (intervals.back() < lower) {
+            intervals.push_back(lower);
+            densities.push_back(0);
+          }
+          intervals.push_back(upper);
+          densities.push_back(bin.weight.data / (upper - lower));
+        }
+        if (std::all_of(
+              std::begin(densities), std::end(densities), [](auto x) { return x == 0; })) {
+          throw common::Error(
+            "Histogram of parameter ", std::quoted(stochastic_distribution.parameter_name),
+            " must have a bin of positive weight");
+        }
+        return [intervals, densities](auto & engine) {
+          return format(std::piecewise_constant_distribution<double>(
+            std::begin(intervals), std::end(intervals), std::begin(densities))(engine));
+        };
+      } else if (stochastic_distribution.is<ProbabilityDistributionSet>()) {
+        const auto & adaptor = stochastic_distribution.as<ProbabilityDistributionSet>().adaptor;
+        return [weights = adaptor.probabilities, values = adaptor.values](auto & engine) {
+          return values[std::discrete_distribution<std::size_t>(
+            std::begin(weights), std::end(weights))(engine)];
+        };
+      } else {
+        throw common::Error(
+          "UserDefinedDistribution of parameter ",
+          std::quoted(stochastic_distribution.parameter_name), " is not supported");
+      }
+    }();
+
+    sample = [name = stochastic_distribution.parameter_name, draw](auto & engine, auto & set) {
+      set.emplace_back(name, draw(engine));
+    };
+  }
+}
+
+auto ParameterDistribution::size() const -> std::size_t
+{
+  if (sample) {
+    return number_of_test_runs;
+  } else {
+    std::size_t size = 1;
+    for (auto && axis : axes) {
+      size *= axis.size;
+    }
+    return size;
+  }
+}
+
+auto ParameterDistribution::operator[](std::size_t index) const -> ParameterSet
+{
+  ParameterSet set;
+
+  if (sample) {
+    auto seed = std::seed_seq{
+      static_cast<std::uint32_t>(random_seed), static_cast<std::uint32_t>(random_seed >> 32),
+      static_cast<std::uint32_t>(index), static_cast<std::uint32_t>(std::uint64_t(index) >> 32)};
+    auto engine = std::mt19937_64(seed);
+    sample(engine, set);
+  } else {
+    for (auto && axis : axes) {
+      axis.assign(index % axis.size, set);
+      index /= axis.size;
+    }
+  }
+
+  return set;
+}
+}  // namespace openscenario_preprocessor
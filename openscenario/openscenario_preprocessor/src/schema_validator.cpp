@@ -0,0 +1,159 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <openscenario_preprocessor/schema_validator.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+#include <sstream>
+#include <xercesc/framework/MemBufInputSource.hpp>
+#include <xercesc/framework/XMLGrammarPoolImpl.hpp>
+#include <xercesc/sax/ErrorHandler.hpp>
+#include <xercesc/sax/SAXException.hpp>
+#include <xercesc/sax/SAXParseException.hpp>
+#include <xercesc/sax2/XMLReaderFactory.hpp>
+#include <xercesc/util/PlatformUtils.hpp>
+#include <xercesc/util/XMLException.hpp>
+#include <xercesc/util/XMLString.hpp>
+#include <xercesc/util/XMLUni.hpp>
+#include <xercesc/validators/common/Grammar.hpp>
+
+namespace openscenario_preprocessor
+{
+namespace
+{
+auto transcode(const XMLCh * const s) -> std::string
+{
+  auto release = [](char * s) { xercesc::XMLString::release(&s); };
+
+  if (const auto transcoded =
+        std::unique_ptr<char, decltype(release)>(xercesc::XMLString::transcode(s), release)) {
+    return transcoded.get();
+  } else {
+    return "";
+  }
+}
+
+struct ErrorCollector : public xercesc::ErrorHandler
+{
+  std::stringstream messages;
+
+  std::size_t count = 0;
+
+  auto warning(const xercesc::SAXParseException &) -> void override {}
+
+  auto error(const xercesc::SAXParseException & exception) -> void override { record(exception); }
+
+  auto fatalError(const xercesc::SAXParseException & exception) -> void override
+  {
+    record(exception);
+  }
+
+  auto resetErrors() -> void override
+  {
+    messages.str("");
+    count = 0;
+  }
+
+  auto record(const xercesc::SAXParseException & exception) -> void
+  {
+    messages << "line " << exception.getLineNumber() << ", column "
+             << exception.getColumnNumber() << ": " << transcode(exception.getMessage())
+             << "\n";
+    ++count;
+  }
+};
+}  // namespace
+
+SchemaValidator::Initialization::Initialization()
+{
+  xercesc::XMLPlatformUtils::Initialize();  // NOTE: reference counted
+}
+
+SchemaValidator::Initialization::~Initialization() { xercesc::XMLPlatformUtils::Terminate(); }
+
+SchemaValidator::SchemaValidator(const boost::filesystem::path & schema)
+: grammar_pool(
+    std::make_unique<xercesc::XMLGrammarPoolImpl>(xercesc::XMLPlatformUtils::fgMemoryManager)),
+  reader(xercesc::XMLReaderFactory::createXMLReader(
+    xercesc::XMLPlatformUtils::fgMemoryManager, grammar_pool.get()))
+{
+  reader->setFeature(xercesc::XMLUni::fgSAX2CoreNameSpaces, true);
+  reader->setFeature(xercesc::XMLUni::fgSAX2CoreValidation, true);
+  reader->setFeature(xercesc::XMLUni::fgXercesDynamic, false);
+  reader->setFeature(xercesc::XMLUni::fgXercesSchema, true);
+  reader->setFeature(xercesc::XMLUni::fgXercesSchemaFullChecking, true);
+  reader->setFeature(xercesc::XMLUni::fgXercesHandleMultipleImports, true);
+
+  /*
+     Validate every file against the grammar loaded here, ignoring any
+     xsi:schemaLocation or xsi:noNamespaceSchemaLocation hints in the files.
+  */
+  reader->setFeature(xercesc::XMLUni::fgXercesUseCachedGrammarInParse, true);
+  reader->setFeature(xercesc::XMLUni::fgXercesCacheGrammarFromParse, false);
+  reader->setFeature(xercesc::XMLUni::fgXercesLoadSchema, false);
+
+  ErrorCollector errors;
+
+  reader->setErrorHandler(&errors);
+
+  if (
+    not reader->loadGrammar(schema.c_str(), xercesc::Grammar::SchemaGrammarType, true) or
+    errors.count) {
+    reader->setErrorHandler(nullptr);
+    throw common::Error("Failed to load XML Schema ", schema, ": ", errors.messages.str());
+  }
+
+  reader->setErrorHandler(nullptr);
+}
+
+auto SchemaValidator::operator()(const boost::filesystem::path & path)
+  -> const std::pair<bool, std::string> &
+{
+  const auto content = [&]() {
+    if (auto file = std::ifstream(path.string()); file) {
+      return std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+    } else {
+      throw common::Error("Failed to open file ", path);
+    }
+  }();
+
+  const auto hash = std::hash<std::string>()(content);
+
+  if (const auto iter = results.find(hash); iter != std::end(results)) {
+    return iter->second;
+  }
+
+  ErrorCollector errors;
+
+  reader->setErrorHandler(&errors);
+
+  try {
+    reader->parse(xercesc::MemBufInputSource(
+      reinterpret_cast<const XMLByte *>(content.data()), content.size(), path.c_str()));
+  } catch (const xercesc::XMLException & exception) {
+    errors.messages << transcode(exception.getMessage()) << "\n";
+    ++errors.count;
+  } catch (const xercesc::SAXException & exception) {
+    errors.messages << transcode(exception.getMessage()) << "\n";
+    ++errors.count;
+  }
+
+  reader->setErrorHandler(nullptr);
+
+  return results.emplace(hash, std::make_pair(errors.count == 0, errors.messages.str()))
+    .first->second;
+}
+}  // namespace openscenario_preprocessor
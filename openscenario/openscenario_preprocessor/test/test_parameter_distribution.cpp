@@ -0,0 +1,223 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <boost/filesystem.hpp>
+#include <cstddef>
+#include <fstream>
+#include <memory>
+#include <openscenario_interpreter/syntax/open_scenario.hpp>
+#include <openscenario_interpreter/syntax/parameter_value_distribution.hpp>
+#include <openscenario_preprocessor/parameter_distribution.hpp>
+#include <scenario_simulator_exception/exception.hpp>
+#include <string>
+
+namespace
+{
+auto makeParameterDistribution(const std::string & distribution_definition)
+  -> openscenario_preprocessor::ParameterDistribution
+{
+  const auto path =
+    boost::filesystem::temp_directory_path() / boost::filesystem::unique_path("%%%%-%%%%.xosc");
+
+  std::ofstream(path.string()) << R"(<?xml version="1.0" encoding="UTF-8"?>
+<OpenSCENARIO>
+  <FileHeader revMajor="1" revMinor="2" date="2022-01-01T00:00:00" description="" author=""/>
+  <ParameterValueDistribution>
+    <ScenarioFile filepath="base.xosc"/>
+    )" << distribution_definition << R"(
+  </ParameterValueDistribution>
+</OpenSCENARIO>
+)";
+
+  const auto script = std::make_shared<openscenario_interpreter::OpenScenario>(path);
+
+  boost::filesystem::remove(path);
+
+  return openscenario_preprocessor::ParameterDistribution(
+    script->category.as<openscenario_interpreter::ParameterValueDistribution>());
+}
+
+auto valueOf(const openscenario_preprocessor::ParameterSet & set, const std::string & name)
+  -> std::string
+{
+  for (auto && [parameter_name, value] : set) {
+    if (parameter_name == name) {
+      return value;
+    }
+  }
+  return "";
+}
+}  // namespace
+
+TEST(ParameterDistribution, deterministic)
+{
+  const auto distribution = makeParameterDistribution(R"(
+    <Deterministic>
+      <DeterministicSingleParameterDistribution parameterName="A">
+        <DistributionSet>
+          <Element value="a0"/>
+          <Element value="a1"/>
+        </DistributionSet>
+      </DeterministicSingleParameterDistribution>
+      <DeterministicSingleParameterDistribution parameterName="B">
+        <DistributionRange stepWidth="0.5">
+          <Range lowerLimit="0" upperLimit="1"/>
+        </DistributionRange>
+      </DeterministicSingleParameterDistribution>
+      <DeterministicMultiParameterDistribution>
+        <ValueSetDistribution>
+          <ParameterValueSet>
+            <ParameterAssignment parameterRef="C" value="c0"/>
+            <ParameterAssignment parameterRef="D" value="d0"/>
+          </ParameterValueSet>
+          <ParameterValueSet>
+            <ParameterAssignment parameterRef="C" value="c1"/>
+            <ParameterAssignment parameterRef="D" value="d1"/>
+          </ParameterValueSet>
+        </ValueSetDistribution>
+      </DeterministicMultiParameterDistribution>
+    </Deterministic>)");
+
+  ASSERT_EQ(distribution.size(), 2u * 3u * 2u);
+
+  /*
+     NOTE: The index is decoded as a mixed radix number whose least significant
+     digit is the first axis.
+  */
+  const auto set = distribution[7];  // 7 = 1 + 2 * (0 + 3 * 1)
+  ASSERT_EQ(set.size(), 4u);
+  EXPECT_EQ(valueOf(set, "A"), "a1");
+  EXPECT_EQ(valueOf(set, "B"), "0");
+  EXPECT_EQ(valueOf(set, "C"), "c1");
+  EXPECT_EQ(valueOf(set, "D"), "d1");
+
+  EXPECT_EQ(valueOf(distribution[4], "B"), "1");
+  EXPECT_EQ(valueOf(distribution[2], "B"), "0.5");
+
+  for (std::size_t i = 0; i < distribution.size(); ++i) {
+    for (std::size_t j = 0; j < i; ++j) {
+      EXPECT_NE(distribution[i], distribution[j]);
+    }
+  }
+}
+
+TEST(ParameterDistribution, stochasticIsReproducible)
+{
+  const auto definition = R"(
+    <Stochastic numberOfTestRuns="10" randomSeed="42">
+      <StochasticDistribution parameterName="X">
+        <UniformDistribution>
+          <Range lowerLimit="-1" upperLimit="1"/>
+        </UniformDistribution>
+      </StochasticDistribution>
+    </Stochastic>)";
+
+  const auto distribution = makeParameterDistribution(definition);
+
+  ASSERT_EQ(distribution.size(), 10u);
+
+  for (std::size_t i = 0; i < distribution.size(); ++i) {
+    const auto x = std::stod(valueOf(distribution[i], "X"));
+    EXPECT_LE(-1, x);
+    EXPECT_LE(x, 1);
+    EXPECT_EQ(distribution[i], makeParameterDistribution(definition)[i]);
+  }
+}
+
+TEST(ParameterDistribution, stochasticWithRandomSeedOutOfRange)
+{
+  auto make = [](const std::string & random_seed) {
+    return makeParameterDistribution(
+      "<Stochastic numberOfTestRuns=\"3\" randomSeed=\"" + random_seed + R"(">
+      <StochasticDistribution parameterName="X">
+        <UniformDistribution>
+          <Range lowerLimit="-1" upperLimit="1"/>
+        </UniformDistribution>
+      </StochasticDistribution>
+    </Stochastic>)");
+  };
+
+  // NOTE: randomSeed is reduced modulo 2^64 = 18446744073709551616
+  EXPECT_EQ(make("18446744073709551616")[0], make("0")[0]);
+  EXPECT_EQ(make("36893488147419103232")[1], make("0")[1]);
+  EXPECT_EQ(make("-18446744073709551616")[2], make("0")[2]);
+  EXPECT_EQ(make("-1")[0], make("-1")[0]);
+  EXPECT_NE(make("-1")[0], make("1")[0]);
+  EXPECT_EQ(make("42.5")[0], make("42")[0]);
+  EXPECT_EQ(make("1e300")[0], make("1e300")[0]);
+
+  EXPECT_NO_THROW(make("INF"));  // NOTE: read as the largest finite Double
+  EXPECT_THROW(make("NaN"), common::Error);
+}
+
+TEST(ParameterDistribution, histogramWithUnsortedAndNonContiguousBins)
+{
+  const auto distribution = makeParameterDistribution(R"(
+    <Stochastic numberOfTestRuns="1000" randomSeed="42">
+      <StochasticDistribution parameterName="X">
+        <Histogram>
+          <Bin weight="1">
+            <Range lowerLimit="10" upperLimit="11"/>
+          </Bin>
+          <Bin weight="3">
+            <Range lowerLimit="0" upperLimit="2"/>
+          </Bin>
+        </Histogram>
+      </StochasticDistribution>
+    </Stochastic>)");
+
+  std::size_t lower_bin_count = 0, upper_bin_count = 0;
+
+  for (std::size_t i = 0; i < distribution.size(); ++i) {
+    const auto x = std::stod(valueOf(distribution[i], "X"));
+    if (0 <= x and x <= 2) {
+      ++lower_bin_count;
+    } else if (10 <= x and x <= 11) {
+      ++upper_bin_count;
+    } else {
+      ADD_FAILURE() << "drew " << x << " outside of the bins";
+    }
+  }
+
+  EXPECT_EQ(lower_bin_count + upper_bin_count, distribution.size());
+  EXPECT_NEAR(lower_bin_count, 750, 100);  // NOTE: weight 3 of 4
+  EXPECT_NEAR(upper_bin_count, 250, 100);  // NOTE: weight 1 of 4
+}
+
+TEST(ParameterDistribution, histogramWithOverlappingBins)
+{
+  EXPECT_THROW(
+    makeParameterDistribution(R"(
+      <Stochastic numberOfTestRuns="1" randomSeed="42">
+        <StochasticDistribution parameterName="X">
+          <Histogram>
+            <Bin weight="1">
+              <Range lowerLimit="0" upperLimit="2"/>
+            </Bin>
+            <Bin weight="1">
+              <Range lowerLimit="1" upperLimit="3"/>
+            </Bin>
+          </Histogram>
+        </StochasticDistribution>
+      </Stochastic>)"),
+    common::Error);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,77 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__ENTITY_TABLE_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__ENTITY_TABLE_HPP_
+
+#include <simulation_api_schema.pb.h>
+#include <traffic_simulator_msgs.pb.h>
+
+#include <cstddef>
+#include <simple_sensor_simulator/sensor_simulation/entity_frame.hpp>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+/*
+   Name-keyed table of the entities spawned in the sensor simulator.
+
+   The entities are stored densely in an EntityFrame (so that the sensors can
+   read them as they are) and indexed by name with a hash map. Lookup,
+   insertion and erasure are O(1); erasure moves the last entity into the
+   hole left by the erased one, so the order of the entities is the order of
+   insertion only until the first erasure.
+*/
+class EntityTable
+{
+  EntityFrame frame_;
+
+  std::vector<bool> is_ego_;
+
+  std::unordered_map<std::string, std::size_t> indices_;
+
+  auto assign(
+    std::size_t index, const traffic_simulator_msgs::EntityType &,
+    const traffic_simulator_msgs::EntitySubtype &, const geometry_msgs::Pose &,
+    const geometry_msgs::Twist &) -> void;
+
+public:
+  /*
+     Returns false (and leaves the table unchanged) if an entity with the same
+     name already exists.
+  */
+  auto insert(const traffic_simulator_msgs::EntityStatus &, bool is_ego) -> bool;
+
+  auto erase(const std::string & name) -> bool;
+
+  auto clear() -> void;
+
+  auto contains(const std::string & name) const -> bool;
+
+  auto isEgo(const std::string & name) const -> bool;
+
+  /*
+     Overwrites the type, the subtype, the pose and the twist of the entity
+     with those of the given status. Throws std::out_of_range if there is no
+     such entity.
+  */
+  auto update(const simulation_api_schema::EntityStatus &) -> void;
+
+  auto frame() const -> const EntityFrame & { return frame_; }
+};
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__ENTITY_TABLE_HPP_
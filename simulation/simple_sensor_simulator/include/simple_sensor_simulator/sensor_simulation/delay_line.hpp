@@ -0,0 +1,103 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__DELAY_LINE_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__DELAY_LINE_HPP_
+
+#include <cmath>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+/*
+   FIFO of timestamped messages that models the output delay of a sensor.
+
+   The messages live in a ring buffer of slots allocated up front. A slot is
+   handed out by next to be filled in place, enqueued by push, and reused
+   (together with the capacity of any buffer its message owns) once it has
+   been popped, so a sensor producing messages at a steady rate does not
+   allocate any message per output.
+
+   The capacity is the number of messages produced during the delay (plus the
+   one being produced). If the sensor ever outpaces it, the ring buffer grows.
+*/
+template <typename T>
+class DelayLine
+{
+  std::vector<std::pair<T, double>> slots_;
+
+  std::size_t head_ = 0;
+
+  std::size_t size_ = 0;
+
+  auto grow() -> void
+  {
+    std::vector<std::pair<T, double>> slots(slots_.size() * 2);
+    for (std::size_t i = 0; i < size_; ++i) {
+      slots[i] = std::move(slots_[(head_ + i) % slots_.size()]);
+    }
+    slots_ = std::move(slots);
+    head_ = 0;
+  }
+
+public:
+  explicit DelayLine(double delay, double period)
+  : slots_(
+      0 < delay and 0 < period ? static_cast<std::size_t>(std::ceil(delay / period)) + 1 : 1)
+  {
+  }
+
+  auto empty() const -> bool { return size_ == 0; }
+
+  /*
+     Returns the slot the next message is to be produced in. The slot holds
+     whatever message was stored in it before, so the caller must overwrite it
+     entirely. It is not enqueued until push is called, so a message that fails
+     to be produced (e.g. because of an exception) is never handed out.
+  */
+  auto next() -> T &
+  {
+    if (size_ == slots_.size()) {
+      grow();
+    }
+    return slots_[(head_ + size_) % slots_.size()].first;
+  }
+
+  /*
+     Enqueues the slot returned by next as the message produced at the given
+     time.
+  */
+  auto push(double time) -> void
+  {
+    if (size_ == slots_.size()) {
+      grow();
+    }
+    slots_[(head_ + size_++) % slots_.size()].second = time;
+  }
+
+  auto front() -> T & { return slots_[head_].first; }
+
+  auto frontTime() const -> double { return slots_[head_].second; }
+
+  auto pop() -> void
+  {
+    head_ = (head_ + 1) % slots_.size();
+    --size_;
+  }
+};
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__DELAY_LINE_HPP_
@@ -17,10 +17,12 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <cstddef>
 #include <memory>
-#include <queue>
 #include <random>
 #include <rclcpp/rclcpp.hpp>
+#include <simple_sensor_simulator/sensor_simulation/delay_line.hpp>
+#include <simple_sensor_simulator/sensor_simulation/entity_frame.hpp>
 #include <string>
 #include <utility>
 #include <vector>
@@ -41,20 +43,17 @@ protected:
   {
   }
 
-  auto isEgoEntityStatusToWhichThisSensorIsAttached(
-    const traffic_simulator_msgs::EntityStatus &) const -> bool;
+  auto isEgoEntityStatusToWhichThisSensorIsAttached(const EntityFrame &, std::size_t) const
+    -> bool;
 
-  auto findEgoEntityStatusToWhichThisSensorIsAttached(
-    const std::vector<traffic_simulator_msgs::EntityStatus> &) const
-    -> std::vector<traffic_simulator_msgs::EntityStatus>::const_iterator;
+  auto findEgoEntityStatusToWhichThisSensorIsAttached(const EntityFrame &) const -> std::size_t;
 
 public:
   virtual ~DetectionSensorBase() = default;
 
   virtual void update(
-    const double current_simulation_time, const std::vector<traffic_simulator_msgs::EntityStatus> &,
-    const rclcpp::Time & current_ros_time,
-    const std::vector<std::string> & lidar_detected_entities) = 0;
+    const double current_simulation_time, const EntityFrame &,
+    const rclcpp::Time & current_ros_time, const std::vector<bool> & lidar_detected_entities) = 0;
 };
 
 template <typename T, typename U = autoware_auto_perception_msgs::msg::TrackedObjects>
@@ -66,11 +65,11 @@ class DetectionSensor : public DetectionSensorBase
 
   std::default_random_engine random_engine_;
 
-  std::queue<std::pair<autoware_auto_perception_msgs::msg::DetectedObjects, double>>
-    detected_objects_queue;
+  DelayLine<autoware_auto_perception_msgs::msg::DetectedObjects> detected_objects_queue;
 
-  std::queue<std::pair<autoware_auto_perception_msgs::msg::TrackedObjects, double>>
-    ground_truth_objects_queue;
+  DelayLine<autoware_auto_perception_msgs::msg::TrackedObjects> ground_truth_objects_queue;
+
+  autoware_auto_perception_msgs::msg::DetectedObjects noisy_detected_objects_;
 
 public:
   explicit DetectionSensor(
@@ -81,15 +80,19 @@ public:
   : DetectionSensorBase(current_simulation_time, configuration),
     detected_objects_publisher(publisher),
     ground_truth_objects_publisher(ground_truth_publisher),
-    random_engine_(configuration.random_seed())
+    random_engine_(configuration.random_seed()),
+    detected_objects_queue(
+      configuration.object_recognition_delay(), configuration.update_duration()),
+    ground_truth_objects_queue(
+      configuration.object_recognition_ground_truth_delay(), configuration.update_duration())
   {
   }
 
   ~DetectionSensor() override = default;
 
   auto update(
-    const double, const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &,
-    const std::vector<std::string> & lidar_detected_entities) -> void override;
+    const double, const EntityFrame &, const rclcpp::Time &,
+    const std::vector<bool> & lidar_detected_entities) -> void override;
 };
 }  // namespace simple_sensor_simulator
 
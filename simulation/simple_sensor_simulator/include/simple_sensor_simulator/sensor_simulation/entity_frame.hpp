@@ -0,0 +1,60 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__ENTITY_FRAME_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__ENTITY_FRAME_HPP_
+
+#include <traffic_simulator_msgs.pb.h>
+
+#include <cstddef>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <geometry_msgs/msg/twist.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
+#include <string>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+/*
+   Entities of the current frame, as the sensors read them.
+
+   Struct of arrays: the i-th element of each array belongs to the i-th
+   entity. Everything the sensors need is extracted from the protobuf
+   messages once when an entity status is updated, so a sensor update neither
+   copies nor converts any message.
+*/
+struct EntityFrame
+{
+  std::vector<std::string> names;
+
+  std::vector<traffic_simulator_msgs::EntityType::Enum> types;
+
+  std::vector<traffic_simulator_msgs::EntitySubtype::Enum> subtypes;
+
+  std::vector<geometry_msgs::msg::Pose> poses;
+
+  std::vector<geometry_msgs::msg::Twist> twists;
+
+  std::vector<geometry_msgs::msg::Point> bounding_box_centers;  // NOTE: in the entity frame
+
+  std::vector<geometry_msgs::msg::Vector3> bounding_box_dimensions;
+
+  std::vector<geometry_msgs::msg::Pose> bounding_box_poses;  // NOTE: in the map frame
+
+  auto size() const -> std::size_t { return names.size(); }
+};
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__ENTITY_FRAME_HPP_
@@ -17,12 +17,16 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <cstddef>
 #include <memory>
-#include <queue>
 #include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
+#include <simple_sensor_simulator/sensor_simulation/delay_line.hpp>
+#include <simple_sensor_simulator/sensor_simulation/entity_frame.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -35,12 +39,14 @@ protected:
   simulation_api_schema::LidarConfiguration configuration_;
 
   Raycaster raycaster_;
-  std::vector<std::string> detected_objects_;
+  std::vector<std::size_t> detected_objects_;  // NOTE: indices of EntityFrame
 
   explicit LidarSensorBase(
     const double current_simulation_time,
-    const simulation_api_schema::LidarConfiguration & configuration)
-  : previous_simulation_time_(current_simulation_time), configuration_(configuration)
+    const simulation_api_schema::LidarConfiguration & configuration, WorkerPool & worker_pool)
+  : previous_simulation_time_(current_simulation_time),
+    configuration_(configuration),
+    raycaster_(worker_pool)
   {
   }
 
@@ -48,10 +54,10 @@ public:
   virtual ~LidarSensorBase() = default;
 
   virtual auto update(
-    const double current_simulation_time, const std::vector<traffic_simulator_msgs::EntityStatus> &,
+    const double current_simulation_time, const EntityFrame &,
     const rclcpp::Time & current_ros_time) -> void = 0;
 
-  auto getDetectedObjects() const -> const std::vector<std::string> & { return detected_objects_; }
+  auto getDetectedObjects() const -> const std::vector<std::size_t> & { return detected_objects_; }
 };
 
 template <typename T>
@@ -59,55 +65,53 @@ class LidarSensor : public LidarSensorBase
 {
   const typename rclcpp::Publisher<T>::SharedPtr publisher_ptr_;
 
-  std::queue<std::pair<sensor_msgs::msg::PointCloud2, double>> queue_pointcloud_;
+  DelayLine<T> delayed_pointclouds_;
 
-  auto raycast(const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-    -> T;
+  auto raycast(const EntityFrame &, const rclcpp::Time &, T &) -> void;
 
 public:
   explicit LidarSensor(
     const double current_simulation_time,
     const simulation_api_schema::LidarConfiguration & configuration,
-    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr)
-  : LidarSensorBase(current_simulation_time, configuration), publisher_ptr_(publisher_ptr)
+    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr, WorkerPool & worker_pool,
+    const std::shared_ptr<const primitives::Primitive> & static_map = nullptr)
+  : LidarSensorBase(current_simulation_time, configuration, worker_pool),
+    publisher_ptr_(publisher_ptr),
+    delayed_pointclouds_(configuration.lidar_sensor_delay(), configuration.scan_duration())
   {
     raycaster_.setDirection(configuration);
+    if (static_map) {
+      raycaster_.addStaticPrimitive(*static_map);
+    }
   }
 
   auto update(
-    const double current_simulation_time,
-    const std::vector<traffic_simulator_msgs::EntityStatus> & status,
+    const double current_simulation_time, const EntityFrame & entities,
     const rclcpp::Time & current_ros_time) -> void override
   {
     if (
       current_simulation_time - previous_simulation_time_ - configuration_.scan_duration() >=
       -0.002) {
       previous_simulation_time_ = current_simulation_time;
-      queue_pointcloud_.push(
-        std::make_pair(raycast(status, current_ros_time), current_simulation_time));
+      raycast(entities, current_ros_time, delayed_pointclouds_.next());
+      delayed_pointclouds_.push(current_simulation_time);
     } else {
       detected_objects_.clear();
     }
 
     if (
-      not queue_pointcloud_.empty() and
-      current_simulation_time - queue_pointcloud_.front().second >=
+      not delayed_pointclouds_.empty() and
+      current_simulation_time - delayed_pointclouds_.frontTime() >=
         configuration_.lidar_sensor_delay()) {
-      const auto pointcloud = queue_pointcloud_.front().first;
-      queue_pointcloud_.pop();
-      publisher_ptr_->publish(pointcloud);
+      publisher_ptr_->publish(delayed_pointclouds_.front());
+      delayed_pointclouds_.pop();
     }
   }
-
-private:
-  // Override
-  Raycaster raycaster_;
 };
 
 template <>
 auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
-  const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &)
-  -> sensor_msgs::msg::PointCloud2;
+  const EntityFrame &, const rclcpp::Time &, sensor_msgs::msg::PointCloud2 &) -> void;
 }  // namespace simple_sensor_simulator
 
 #endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__LIDAR_SENSOR_HPP_
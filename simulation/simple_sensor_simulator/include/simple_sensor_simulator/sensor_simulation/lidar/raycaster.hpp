@@ -16,18 +16,21 @@
 #define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__RAYCASTER_HPP_
 
 #include <embree4/rtcore.h>
-#include <pcl_conversions/pcl_conversions.h>
 #include <quaternion_operation/quaternion_operation.h>
+#include <simulation_api_schema.pb.h>
 
+#include <cstddef>
+#include <functional>
 #include <geometry_msgs/msg/pose.hpp>
 #include <geometry_msgs/msg/vector3.hpp>
 #include <memory>
 #include <random>
+#include <rclcpp/rclcpp.hpp>
 #include <sensor_msgs/msg/point_cloud2.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
 #include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
@@ -36,22 +39,32 @@ namespace simple_sensor_simulator
 class Raycaster
 {
 public:
-  Raycaster();
-  explicit Raycaster(std::string embree_config);
+  explicit Raycaster(WorkerPool & worker_pool);
+  explicit Raycaster(WorkerPool & worker_pool, std::string embree_config);
   ~Raycaster();
+  /*
+     The id identifies the primitive in getDetectedObject (e.g. the index of
+     the entity the primitive represents), and must be unique until the next
+     raycast.
+  */
   template <typename T, typename... Ts>
-  void addPrimitive(std::string name, Ts &&... xs)
+  void addPrimitive(std::size_t id, Ts &&... xs)
   {
-    if (primitive_ptrs_.count(name) != 0) {
-      throw std::runtime_error("primitive " + name + " already exist.");
-    }
-    auto primitive_ptr = std::make_unique<T>(std::forward<Ts>(xs)...);
-    primitive_ptrs_.emplace(name, std::move(primitive_ptr));
+    primitive_ptrs_.emplace_back(id, std::make_unique<T>(std::forward<Ts>(xs)...));
   }
-  const sensor_msgs::msg::PointCloud2 raycast(
+  /*
+     Adds a primitive that stays in the scene for every following raycast
+     (e.g. the static map). It is never reported by getDetectedObject.
+  */
+  void addStaticPrimitive(const primitives::Primitive & primitive);
+  void raycast(
     const std::string & frame_id, const rclcpp::Time & stamp,
-    const geometry_msgs::msg::Pose & origin, double max_distance = 300, double min_distance = 0);
-  const std::vector<std::string> & getDetectedObject() const;
+    const geometry_msgs::msg::Pose & origin, sensor_msgs::msg::PointCloud2 & pointcloud_msg,
+    double max_distance = 300, double min_distance = 0);
+  /*
+     Returns the ids of the primitives hit by the last raycast, each only once.
+  */
+  const std::vector<std::size_t> & getDetectedObject() const;
   void setDirection(
     const simulation_api_schema::LidarConfiguration & configuration,
     double horizontal_angle_start = 0, double horizontal_angle_end = 2 * M_PI);
@@ -60,29 +73,38 @@ private:
   std::vector<geometry_msgs::msg::Quaternion> getDirections(
     const std::vector<double> & vertical_angles, double horizontal_angle_start,
     double horizontal_angle_end, double horizontal_resolution);
+  WorkerPool & worker_pool_;
   std::vector<geometry_msgs::msg::Quaternion> directions_;
   double previous_horizontal_angle_start_;
   double previous_horizontal_angle_end_;
   double previous_horizontal_resolution_;
   std::vector<double> previous_vertical_angles_;
-  std::unordered_map<std::string, std::unique_ptr<primitives::Primitive>> primitive_ptrs_;
+  std::vector<std::pair<std::size_t, std::unique_ptr<primitives::Primitive>>> primitive_ptrs_;
   RTCDevice device_;
   RTCScene scene_;
+  /*
+     NOTE: Static primitives are kept in a scene of their own, instanced once
+     into scene_, so that their acceleration structure is built only when they
+     are added instead of on every raycast.
+  */
+  RTCScene static_scene_ = nullptr;
   std::random_device seed_gen_;
   std::default_random_engine engine_;
-  std::vector<std::string> detected_objects_;
-  std::unordered_map<unsigned int, std::string> geometry_ids_;
+  std::vector<std::size_t> detected_objects_;
   std::vector<Eigen::Matrix3d> rotation_matrices_;
+  // x, y, z and intensity of the points hit by each worker, kept to reuse their capacity
+  std::vector<std::vector<float>> thread_points_;
 
   static void intersect(
     int thread_id, int thread_count, RTCScene scene,
-    pcl::PointCloud<pcl::PointXYZI>::Ptr thread_cloud, geometry_msgs::msg::Pose origin,
-    std::reference_wrapper<std::set<unsigned int>> ref_thread_detected_ids, double max_distance,
+    std::reference_wrapper<std::vector<float>> ref_thread_points, geometry_msgs::msg::Pose origin,
+    std::reference_wrapper<std::vector<bool>> ref_thread_detected_ids, double max_distance,
     double min_distance,
     std::reference_wrapper<const std::vector<Eigen::Matrix3d>> ref_rotation_matrices)
   {
     auto & rotation_matrices = ref_rotation_matrices.get();
     auto & thread_detected_ids = ref_thread_detected_ids.get();
+    auto & thread_points = ref_thread_points.get();
     const auto orientation_matrix = quaternion_operation::getRotationMatrix(origin.orientation);
     for (unsigned int i = thread_id; i < rotation_matrices.size(); i += thread_count) {
       RTCRayHit rayhit = {};
@@ -104,14 +126,13 @@ private:
 
       if (rayhit.hit.geomID != RTC_INVALID_GEOMETRY_ID) {
         double distance = rayhit.ray.tfar;
-        pcl::PointXYZI p;
-        {
-          p.x = rotation_matrices.at(i)(0) * distance;
-          p.y = rotation_matrices.at(i)(1) * distance;
-          p.z = rotation_matrices.at(i)(2) * distance;
+        thread_points.push_back(rotation_matrices.at(i)(0) * distance);
+        thread_points.push_back(rotation_matrices.at(i)(1) * distance);
+        thread_points.push_back(rotation_matrices.at(i)(2) * distance);
+        thread_points.push_back(0);  // intensity
+        if (rayhit.hit.instID[0] == RTC_INVALID_GEOMETRY_ID) {  // NOTE: not a static primitive
+          thread_detected_ids[rayhit.hit.geomID] = true;
         }
-        thread_cloud->emplace_back(p);
-        thread_detected_ids.insert(rayhit.hit.geomID);
       }
     }
   }
@@ -0,0 +1,33 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__STATIC_MAP_MESH_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__STATIC_MAP_MESH_HPP_
+
+#include <lanelet2_core/LaneletMap.h>
+
+#include <simple_sensor_simulator/sensor_simulation/primitives/mesh.hpp>
+
+namespace simple_sensor_simulator
+{
+/*
+   Builds the mesh of the static part of the map for lidars to hit: the road
+   surface of every lanelet (triangulated between its left and right bounds)
+   and, for every area that has a "height" attribute, the walls of its outer
+   bound extruded upwards by that height (e.g. buildings).
+*/
+auto makeStaticMapMesh(const lanelet::LaneletMapConstPtr &) -> primitives::Mesh;
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__LIDAR__STATIC_MAP_MESH_HPP_
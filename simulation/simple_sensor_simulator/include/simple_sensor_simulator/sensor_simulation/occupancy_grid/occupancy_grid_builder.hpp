@@ -18,7 +18,9 @@
 #include <Eigen/Core>
 #include <geometry_msgs/msg/point.hpp>
 #include <geometry_msgs/msg/pose.hpp>
+#include <optional>
 #include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -37,9 +39,15 @@ class OccupancyGridBuilder
   using PolygonType = std::vector<PointType>;
 
 public:
+  /**
+   * @param worker_pool Threads to build on, which must outlive the builder
+   * @note The work of a build is split into as many parts as the threads of
+   *       `worker_pool`, each of which is processed with working memory of its
+   *       own. The result does not depend on the threads running them
+   */
   OccupancyGridBuilder(
-    double resolution, size_t height, size_t width, int8_t occupied_cost = 100,
-    int8_t invisible_cost = 50);
+    WorkerPool & worker_pool, double resolution, size_t height, size_t width,
+    int8_t occupied_cost = 100, int8_t invisible_cost = 50);
 
   const double resolution;
   const size_t height;
@@ -48,21 +56,52 @@ public:
   const int8_t invisible_cost;
 
   /**
-   * @brief Mark invisible area and occupied area of primitive
+   * @brief Add primitive to the occupancy grid of the current frame
    * @param primitive
    */
   auto add(const PrimitiveType & primitive) -> void;
 
   /**
-   * @brief Reset all internal state
+   * @brief Add primitive to the occupancy grid of the current frame, identified by the number of
+   *        primitives added before it in the frame
+   * @param convex_hull 2D convex hull of primitive in world coordinate
+   */
+  auto add(const PolygonType & convex_hull) -> void;
+
+  /**
+   * @brief Add primitive to the occupancy grid of the current frame
+   * @param convex_hull 2D convex hull of primitive in world coordinate
+   * @param id Small integer identifying the primitive across frames (e.g. the index of its
+   *        entity), unique in a frame
+   * @note This does not allocate memory unless a greater id is added than ever before
+   */
+  auto add(const PolygonType & convex_hull, size_t id) -> void;
+
+  /**
+   * @brief Start a new frame
    * @param origin
+   * @note Areas of primitives are kept across frames, and areas of primitives
+   *       which are added again unchanged with the same id and origin are not
+   *       recomputed
    */
   auto reset(const PoseType & origin) -> void;
 
   /**
-   * @brief Build occupancy grid
+   * @brief Build occupancy grid, updating only the rows changed since the previous build
+   * @note Primitives are rasterized and rows are summed up concurrently, and
+   *       the result is identical to the one built on a single thread
+   * @note The grids are kept in grid coordinate, so they are updated
+   *       incrementally only while the origin stays the same (e.g. while the
+   *       ego is stopped). If the origin moves, every primitive moves on the
+   *       grid and so does the invisible area behind it, so the grids are
+   *       built from scratch
+   * @note Memory of the grids and footprints is reused across builds, but
+   *       every primitive rasterized (i.e. every primitive if the origin
+   *       moved) allocates temporary polygons of its areas
+   * @return The number of primitives rasterized, which are those added or
+   *         changed since the previous build, or all of them if the origin moved
    */
-  auto build() -> void;
+  auto build() -> size_t;
 
   /**
    * @return Constructed occupancy grid
@@ -70,25 +109,100 @@ public:
   auto get() const -> const OccupancyGridType &;
 
 private:
+  /**
+   * @brief Marked cells of a row, as a half-open column range [begin, end)
+   */
+  struct Span
+  {
+    int32_t row;
+    int32_t begin;
+    int32_t end;
+  };
+
+  using SpansType = std::vector<Span>;
+
+  /**
+   * @brief Rasterized areas of a primitive, kept across frames
+   */
+  struct Footprint
+  {
+    /**
+     * @brief Convex hull of the primitive in world coordinate
+     */
+    PolygonType convex_hull;
+
+    SpansType occupied_spans;
+
+    SpansType invisible_spans;
+
+    /**
+     * @brief Whether the primitive is added in the current frame
+     */
+    bool is_added = false;
+
+    /**
+     * @brief Whether the spans are marked on the grids
+     */
+    bool is_marked = false;
+
+    /**
+     * @brief Whether the convex hull changed since the spans were marked
+     */
+    bool is_changed = false;
+  };
+
   /**
    * @brief Grid origin in world coordinate
    */
   PoseType origin_;
 
+  /**
+   * @brief Grid origin of the previous build
+   */
+  std::optional<PoseType> built_origin_;
+
   /**
    * @brief The number of added primitives
    */
   MarkerCounterType primitive_count_ = 0;
 
   /**
-   * @brief A vector of occupied area
+   * @brief Footprints of primitives, indexed by id
+   * @note Footprints of the ids not added in the current frame are kept to
+   *       reuse allocated memory
+   */
+  std::vector<Footprint> footprints_;
+
+  /**
+   * @brief Ids of the primitives to rasterize in a build
    * @note This vector is declared as a member to reuse allocated memory
    */
+  std::vector<size_t> rasterized_ids_;
+
+  /**
+   * @brief Rows whose markers changed since the previous build
+   */
+  std::vector<bool> dirty_rows_;
+
+  /**
+   * @brief Threads to build on, shared with the other sensors
+   */
+  WorkerPool & worker_pool_;
+
+  /**
+   * @brief The number of parts the work of a build is split into
+   */
+  size_t worker_count_;
+
+  /**
+   * @brief A vector of occupied area
+   * @note This vector holds differences between adjacent cells of each row
+   */
   MarkerGridType occupied_grid_;
 
   /**
    * @brief A vector of invisible area
-   * @note This vector is declared as a member to reuse allocated memory
+   * @note This vector holds differences between adjacent cells of each row
    */
   MarkerGridType invisible_grid_;
 
@@ -99,17 +213,28 @@ private:
   OccupancyGridType values_;
 
   /**
-   * @brief Vectors to hold min or max column of rasterized polygon
+   * @brief Vectors to hold min or max column of rasterized polygon, for each worker
    * @note These vectors are declared as members to reuse allocated memory
    */
-  std::vector<int32_t> min_cols_, max_cols_;
+  std::vector<std::vector<int32_t>> min_cols_, max_cols_;
 
   /**
-   * @brief Mark grid area of convex hull
+   * @brief Rasterize convex hull into spans of each row clipped to the grid
+   * @param convex_hull Convex hull to rasterize
+   * @param spans Spans of the convex hull
+   * @param worker_id Worker to use the working memory of
+   */
+  inline auto rasterize(const PolygonType & convex_hull, SpansType & spans, size_t worker_id)
+    -> void;
+
+  /**
+   * @brief Add delta to the markers of spans, and flag their rows as dirty
    * @param grid Grid to be marked
-   * @param convex_hull Convex hull to mark
+   * @param spans Spans to mark
+   * @param delta 1 to mark, -1 to unmark
    */
-  inline auto addPolygon(MarkerGridType & grid, const PolygonType & convex_hull) -> void;
+  inline auto mark(MarkerGridType & grid, const SpansType & spans, MarkerCounterType delta)
+    -> void;
 
   /**
    * @brief Convert point in world coordinate to point in grid coordinate
@@ -136,10 +261,10 @@ private:
 
   /**
    * @brief Construct a convex hull of the area occupied with primitive
-   * @param primitive
+   * @param convex_hull Convex hull of primitive in world coordinate
    * @return Convex hull polygon
    */
-  inline auto makeOccupiedArea(const PrimitiveType & primitive) const -> PolygonType;
+  inline auto makeOccupiedArea(const PolygonType & convex_hull) const -> PolygonType;
 
   /**
    * @brief Construct a convex hull of the area made invisible by the occupied area
@@ -17,10 +17,16 @@
 
 #include <simulation_api_schema.pb.h>
 
+#include <cstddef>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
 #include <memory>
 #include <nav_msgs/msg/occupancy_grid.hpp>
 #include <rclcpp/rclcpp.hpp>
+#include <simple_sensor_simulator/sensor_simulation/entity_frame.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_builder.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
 #include <string>
 #include <vector>
 
@@ -36,7 +42,33 @@ protected:
 
   simulation_api_schema::OccupancyGridSensorConfiguration configuration_;
 
-  std::vector<std::string> detected_objects_;
+  /**
+   * @brief Convex hull of the bounding box of an entity, kept across frames
+   */
+  struct EntityPrimitive
+  {
+    std::string name;
+
+    geometry_msgs::msg::Vector3 dimensions;
+
+    geometry_msgs::msg::Pose pose;
+
+    std::vector<geometry_msgs::msg::Point> convex_hull;
+  };
+
+  /**
+   * @brief Primitives of the entities detected so far, indexed in the same way as EntityFrame
+   * @note Convex hulls are recomputed only when the entity at the index or its bounding box
+   *       changes. Slots are never freed, so that no memory is allocated for entities which are
+   *       detected again
+   */
+  std::vector<EntityPrimitive> primitives_;
+
+  /**
+   * @brief Whether each entity is detected, indexed in the same way as EntityFrame
+   * @note This vector is declared as a member to reuse allocated memory
+   */
+  std::vector<bool> detected_entities_;
 
   explicit OccupancyGridSensorBase(
     const double current_simulation_time,
@@ -52,27 +84,25 @@ public:
    * @brief Update sensor status
    */
   virtual void update(
-    const double current_simulation_time, const std::vector<traffic_simulator_msgs::EntityStatus> &,
-    const rclcpp::Time & current_ros_time,
-    const std::vector<std::string> & lidar_detected_entities) = 0;
+    const double current_simulation_time, const EntityFrame &,
+    const rclcpp::Time & current_ros_time, const std::vector<bool> & lidar_detected_entities) = 0;
 
   /**
    * @brief List all objects in range of sensor sight
-   * @warning `status` must contain EGO object
-   * @return names of objects in range of sensor sight
+   * @warning `entities` must contain EGO object
+   * @param detected_entities whether each object of `entities` is in range of sensor sight
    */
-  const std::vector<std::string> getDetectedObjects(
-    const std::vector<traffic_simulator_msgs::EntityStatus> & status,
-    const std::vector<std::string> & lidar_detected_entities) const;
+  void getDetectedObjects(
+    const EntityFrame & entities, const std::vector<bool> & lidar_detected_entities,
+    std::vector<bool> & detected_entities) const;
 
   /**
    * @brief Extract sensor pose from entity statuses
    * @return sensor pose
-   * @warning `status` must contain EGO object
-   * @exception SimulationRuntimeError if `status` does not contain EGO object
+   * @warning `entities` must contain EGO object
+   * @exception SimulationRuntimeError if `entities` does not contain EGO object
    */
-  geometry_msgs::Pose getSensorPose(
-    const std::vector<traffic_simulator_msgs::EntityStatus> &) const;
+  const geometry_msgs::msg::Pose & getSensorPose(const EntityFrame &) const;
 };
 
 /**
@@ -84,28 +114,25 @@ class OccupancyGridSensor : public OccupancyGridSensorBase
   const typename rclcpp::Publisher<T>::SharedPtr publisher_ptr_;
 
   /**
-   * @brief construct occupancy grid from entity list
-   * @return occupancy grid of specified type
+   * @brief Occupancy grid message, declared as a member to reuse allocated memory
    */
-  auto getOccupancyGrid(
-    const std::vector<traffic_simulator_msgs::EntityStatus> &, const rclcpp::Time &,
-    const std::vector<std::string> &) -> T;
+  T occupancy_grid_;
 
 public:
   explicit OccupancyGridSensor(
     const double current_simulation_time,
     const simulation_api_schema::OccupancyGridSensorConfiguration & configuration,
-    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr)
+    const typename rclcpp::Publisher<T>::SharedPtr & publisher_ptr, WorkerPool & worker_pool)
   : OccupancyGridSensorBase(current_simulation_time, configuration),
     publisher_ptr_(publisher_ptr),
-    builder_(configuration.resolution(), configuration.height(), configuration.width())
+    builder_(
+      worker_pool, configuration.resolution(), configuration.height(), configuration.width())
   {
   }
 
   auto update(
-    const double current_simulation_time,
-    const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
-    const rclcpp::Time & current_ros_time, const std::vector<std::string> & lidar_detected_entities)
+    const double current_simulation_time, const EntityFrame & entities,
+    const rclcpp::Time & current_ros_time, const std::vector<bool> & lidar_detected_entities)
     -> void override
   {
     if (
@@ -114,19 +141,26 @@ public:
       previous_simulation_time_ = current_simulation_time;
       publisher_ptr_->publish(
         getOccupancyGrid(entities, current_ros_time, lidar_detected_entities));
-    } else {
-      detected_objects_ = {};
     }
   }
 
 private:
+  friend class OccupancyGridSensorTest;
+
   mutable OccupancyGridBuilder builder_;
+
+  /**
+   * @brief construct occupancy grid from entity list
+   * @return occupancy grid of specified type
+   */
+  auto getOccupancyGrid(
+    const EntityFrame &, const rclcpp::Time &, const std::vector<bool> &) -> const T &;
 };
 
 template <>
 auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & status, const rclcpp::Time & stamp,
-  const std::vector<std::string> & lidar_detected_entities) -> nav_msgs::msg::OccupancyGrid;
+  const EntityFrame & entities, const rclcpp::Time & stamp,
+  const std::vector<bool> & lidar_detected_entities) -> const nav_msgs::msg::OccupancyGrid &;
 }  // namespace simple_sensor_simulator
 
 #endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__OCCUPANCY_GRID__OCCUPANCY_GRID_SENSOR_HPP_
@@ -0,0 +1,37 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__MESH_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__MESH_HPP_
+
+#include <simple_sensor_simulator/sensor_simulation/primitives/primitive.hpp>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+/*
+   Arbitrary triangle mesh whose vertices are given in the map frame.
+*/
+class Mesh : public Primitive
+{
+public:
+  explicit Mesh(std::vector<Vertex> vertices, std::vector<Triangle> triangles);
+  ~Mesh() = default;
+};
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__PRIMITIVES__MESH_HPP_
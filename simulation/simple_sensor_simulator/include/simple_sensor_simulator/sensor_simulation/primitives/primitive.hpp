@@ -54,7 +54,7 @@ public:
   virtual ~Primitive() = default;
   const std::string type;
   const geometry_msgs::msg::Pose pose;
-  unsigned int addToScene(RTCDevice device, RTCScene scene);
+  unsigned int addToScene(RTCDevice device, RTCScene scene) const;
   std::vector<Vertex> getVertex() const;
   std::vector<Triangle> getTriangles() const;
   std::vector<geometry_msgs::msg::Point> get2DConvexHull() const;
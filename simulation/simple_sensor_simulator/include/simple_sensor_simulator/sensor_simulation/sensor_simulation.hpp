@@ -25,9 +25,11 @@
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
 #include <simple_sensor_simulator/sensor_simulation/detection_sensor/detection_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/entity_frame.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/traffic_lights/traffic_lights_detector.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
 #include <vector>
 
 namespace simple_sensor_simulator
@@ -37,13 +39,15 @@ class SensorSimulation
 public:
   auto attachLidarSensor(
     const double current_simulation_time,
-    const simulation_api_schema::LidarConfiguration & configuration, rclcpp::Node & node) -> void
+    const simulation_api_schema::LidarConfiguration & configuration, rclcpp::Node & node,
+    const std::shared_ptr<const primitives::Primitive> & static_map = nullptr) -> void
   {
     if (configuration.architecture_type().find("awf/universe") != std::string::npos) {
       lidar_sensors_.push_back(std::make_unique<LidarSensor<sensor_msgs::msg::PointCloud2>>(
         current_simulation_time, configuration,
         node.create_publisher<sensor_msgs::msg::PointCloud2>(
-          "/perception/obstacle_segmentation/pointcloud", 1)));
+          "/perception/obstacle_segmentation/pointcloud", 1),
+        worker_pool_, static_map));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -82,7 +86,7 @@ public:
       using Message = nav_msgs::msg::OccupancyGrid;
       occupancy_grid_sensors_.push_back(std::make_unique<OccupancyGridSensor<Message>>(
         current_simulation_time, configuration,
-        node.create_publisher<Message>("/perception/occupancy_grid_map/map", 1)));
+        node.create_publisher<Message>("/perception/occupancy_grid_map/map", 1), worker_pool_));
     } else {
       std::stringstream ss;
       ss << "Unexpected architecture_type " << std::quoted(configuration.architecture_type())
@@ -114,16 +118,31 @@ public:
     }
   }
 
+  auto detachAllSensors() -> void
+  {
+    lidar_sensors_.clear();
+    detection_sensors_.clear();
+    occupancy_grid_sensors_.clear();
+    traffic_lights_detectors_.clear();
+  }
+
   auto updateSensorFrame(
     double current_simulation_time, const rclcpp::Time & current_ros_time,
-    const std::vector<traffic_simulator_msgs::EntityStatus> &,
-    const simulation_api_schema::UpdateTrafficLightsRequest &) -> void;
+    const EntityFrame &, const simulation_api_schema::UpdateTrafficLightsRequest &) -> void;
 
 private:
+  /*
+     NOTE: Declared before the sensors, so that it outlives the raycasters and
+     occupancy grid builders running their tasks on it.
+  */
+  WorkerPool worker_pool_;
+
   std::vector<std::unique_ptr<LidarSensorBase>> lidar_sensors_;
   std::vector<std::unique_ptr<DetectionSensorBase>> detection_sensors_;
   std::vector<std::unique_ptr<OccupancyGridSensorBase>> occupancy_grid_sensors_;
   std::vector<std::unique_ptr<traffic_lights::TrafficLightsDetector>> traffic_lights_detectors_;
+
+  std::vector<bool> lidar_detected_entities_;
 };
 }  // namespace simple_sensor_simulator
 
@@ -0,0 +1,119 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#ifndef SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__WORKER_POOL_HPP_
+#define SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__WORKER_POOL_HPP_
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+/*
+   Threads shared by the sensors (and by the raycasters and occupancy grid
+   builders of the sensors), which run tasks together with the threads waiting
+   for them.
+
+   The thread calling `run` takes part in running the tasks it is waiting for,
+   and waits only for the tasks other threads have already started. So `run`
+   may be called from a task of the pool itself (e.g. a lidar raycasting while
+   the sensors are updated concurrently) without deadlock, and no more threads
+   than the pool has plus those calling `run` from outside ever run tasks.
+*/
+class WorkerPool
+{
+public:
+  /*
+     By default, as many threads as physical cores run tasks (including the
+     calling thread), which is usually half the number of hardware threads.
+     In heavy loads, hyper-threading adds little to the overall performance.
+  */
+  explicit WorkerPool(std::size_t size = std::max(1u, std::thread::hardware_concurrency() / 2));
+
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool &) = delete;
+
+  auto operator=(const WorkerPool &) -> WorkerPool & = delete;
+
+  /*
+     The number of threads that may run the tasks of a call to `run`,
+     including the calling thread.
+  */
+  auto size() const noexcept -> std::size_t { return threads_.size() + 1; }
+
+  /*
+     Calls f(i) for each i in [0, count) concurrently, and returns when all of
+     them have returned. If any of them throws, the first exception is
+     rethrown after all of them have returned.
+  */
+  template <typename F>
+  auto run(std::size_t count, F && f) -> void
+  {
+    run(
+      count,
+      [](const void * f, std::size_t i) {
+        (*static_cast<std::remove_reference_t<F> *>(const_cast<void *>(f)))(i);
+      },
+      &f);
+  }
+
+private:
+  /*
+     NOTE: A job lives on the stack of the thread calling `run`, which removes
+     it from `jobs_` and waits for its helpers before returning.
+  */
+  struct Job
+  {
+    std::size_t count;
+
+    void (*call)(const void *, std::size_t);
+
+    const void * f;
+
+    std::atomic<std::size_t> next = 0;
+
+    std::size_t helper_count = 0;  // NOTE: guarded by mutex_
+
+    std::exception_ptr exception = nullptr;  // NOTE: guarded by mutex_
+  };
+
+  auto run(std::size_t, void (*)(const void *, std::size_t), const void *) -> void;
+
+  auto work(Job &) -> void;
+
+  std::mutex mutex_;
+
+  std::condition_variable condition_;
+
+  /*
+     Jobs which may have tasks not claimed yet, in the order they were given.
+  */
+  std::deque<Job *> jobs_;
+
+  bool is_stop_requested_ = false;
+
+  std::vector<std::thread> threads_;
+};
+}  // namespace simple_sensor_simulator
+
+#endif  // SIMPLE_SENSOR_SIMULATOR__SENSOR_SIMULATION__WORKER_POOL_HPP_
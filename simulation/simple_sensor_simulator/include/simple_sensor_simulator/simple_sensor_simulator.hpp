@@ -21,17 +21,19 @@
 #include <geographic_msgs/msg/geo_point.hpp>
 #include <geometry_msgs/msg/pose_stamped.hpp>
 #include <geometry_msgs/msg/transform_stamped.hpp>
-#include <map>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
+#include <simple_sensor_simulator/entity_table.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/static_map_mesh.hpp>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/ego_entity_simulation.hpp>
 #include <simulation_interface/zmq_multi_server.hpp>
 #include <string>
 #include <thread>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
+#include <tuple>
 #include <vector>
 #include <visualization_msgs/msg/marker_array.hpp>
 
@@ -137,26 +139,31 @@ private:
 
   int getSocketPort();
 
-  std::vector<traffic_simulator_msgs::VehicleParameters> ego_vehicles_;
-  std::vector<traffic_simulator_msgs::VehicleParameters> vehicles_;
-  std::vector<traffic_simulator_msgs::PedestrianParameters> pedestrians_;
-  std::vector<traffic_simulator_msgs::MiscObjectParameters> misc_objects_;
+  EntityTable entities_;
   double realtime_factor_;
   double step_time_;
   double current_simulation_time_;
   double current_scenario_time_;
   rclcpp::Time current_ros_time_;
   bool initialized_;
-  std::map<std::string, simulation_api_schema::EntityStatus> entity_status_;
   simulation_api_schema::UpdateTrafficLightsRequest traffic_signals_states_;
-  traffic_simulator_msgs::BoundingBox getBoundingBox(const std::string & name);
   zeromq::MultiServer server_;
   geographic_msgs::msg::GeoPoint getOrigin();
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_;
+  /*
+     Path, hash of the content and origin (latitude and longitude) of the map
+     hdmap_utils_ was built from. Consecutive initializations with the same
+     key reuse hdmap_utils_ instead of loading the map again.
+  */
+  std::tuple<std::string, std::size_t, double, double> hdmap_utils_key_;
+  /*
+     Mesh of the static map shared by all lidars, built on the first lidar
+     attached after hdmap_utils_ is (re)built if the parameter
+     "lidar_static_map" (declared on construction) is true.
+  */
+  std::shared_ptr<const primitives::Primitive> lidar_static_map_;
+  auto getLidarStaticMap() -> std::shared_ptr<const primitives::Primitive>;
   std::shared_ptr<vehicle_simulation::EgoEntitySimulation> ego_entity_simulation_;
-
-  bool isEgo(const std::string & name);
-  bool isEntityExists(const std::string & name);
 };
 }  // namespace simple_sensor_simulator
 
@@ -17,6 +17,7 @@
 
 #include <concealer/autoware.hpp>
 #include <memory>
+#include <rclcpp/node_interfaces/node_parameters_interface.hpp>
 #include <simple_sensor_simulator/vehicle_simulation/vehicle_model/sim_model.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator_msgs/msg/entity_status.hpp>
@@ -49,11 +50,13 @@ private:
 
   geometry_msgs::msg::Pose initial_pose_;
 
-  static auto getVehicleModelType() -> VehicleModelType;
+  static auto getVehicleModelType(const rclcpp::node_interfaces::NodeParametersInterface &)
+    -> VehicleModelType;
 
   static auto makeSimulationModel(
     const VehicleModelType, const double step_time,
-    const traffic_simulator_msgs::msg::VehicleParameters &)
+    const traffic_simulator_msgs::msg::VehicleParameters &,
+    const rclcpp::node_interfaces::NodeParametersInterface &)
     -> const std::shared_ptr<SimModelInterface>;
 
   traffic_simulator_msgs::msg::EntityStatus status_;
@@ -89,8 +92,10 @@ public:
 
   explicit EgoEntitySimulation(
     const traffic_simulator_msgs::msg::VehicleParameters &, double,
-    const std::shared_ptr<hdmap_utils::HdMapUtils> &, const rclcpp::Parameter & use_sim_time,
-    const bool consider_acceleration_by_road_slope, const bool consider_pose_by_road_slope);
+    const std::shared_ptr<hdmap_utils::HdMapUtils> &,
+    const rclcpp::node_interfaces::NodeParametersInterface &,
+    const rclcpp::Parameter & use_sim_time, const bool consider_acceleration_by_road_slope,
+    const bool consider_pose_by_road_slope);
 
   auto overwrite(
     const traffic_simulator_msgs::msg::EntityStatus & status, double current_scenario_time,
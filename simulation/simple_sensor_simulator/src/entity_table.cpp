@@ -0,0 +1,123 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <quaternion_operation/quaternion_operation.h>
+
+#include <simple_sensor_simulator/entity_table.hpp>
+#include <simulation_interface/conversions.hpp>
+#include <string>
+#include <utility>
+
+namespace simple_sensor_simulator
+{
+auto EntityTable::assign(
+  std::size_t index, const traffic_simulator_msgs::EntityType & type,
+  const traffic_simulator_msgs::EntitySubtype & subtype, const geometry_msgs::Pose & pose,
+  const geometry_msgs::Twist & twist) -> void
+{
+  frame_.types[index] = type.type();
+  frame_.subtypes[index] = subtype.value();
+  simulation_interface::toMsg(pose, frame_.poses[index]);
+  simulation_interface::toMsg(twist, frame_.twists[index]);
+
+  const auto & center = frame_.bounding_box_centers[index];
+  const Eigen::Vector3d offset =
+    quaternion_operation::getRotationMatrix(frame_.poses[index].orientation) *
+    Eigen::Vector3d(center.x, center.y, center.z);
+  auto & bounding_box_pose = frame_.bounding_box_poses[index] = frame_.poses[index];
+  bounding_box_pose.position.x += offset.x();
+  bounding_box_pose.position.y += offset.y();
+  bounding_box_pose.position.z += offset.z();
+}
+
+auto EntityTable::insert(const traffic_simulator_msgs::EntityStatus & status, bool is_ego) -> bool
+{
+  if (const auto [iter, inserted] = indices_.emplace(status.name(), frame_.size()); inserted) {
+    frame_.names.push_back(status.name());
+    frame_.types.emplace_back();
+    frame_.subtypes.emplace_back();
+    frame_.poses.emplace_back();
+    frame_.twists.emplace_back();
+    simulation_interface::toMsg(
+      status.bounding_box().center(), frame_.bounding_box_centers.emplace_back());
+    simulation_interface::toMsg(
+      status.bounding_box().dimensions(), frame_.bounding_box_dimensions.emplace_back());
+    frame_.bounding_box_poses.emplace_back();
+    is_ego_.push_back(is_ego);
+    assign(
+      iter->second, status.type(), status.subtype(), status.pose(),
+      status.action_status().twist());
+    return true;
+  } else {
+    return false;
+  }
+}
+
+auto EntityTable::erase(const std::string & name) -> bool
+{
+  if (const auto iter = indices_.find(name); iter != std::end(indices_)) {
+    const auto index = iter->second;
+    auto remove = [&](auto & v) {
+      if (index + 1 != v.size()) {
+        v[index] = std::move(v.back());
+      }
+      v.pop_back();
+    };
+    indices_.erase(iter);
+    remove(frame_.names);
+    remove(frame_.types);
+    remove(frame_.subtypes);
+    remove(frame_.poses);
+    remove(frame_.twists);
+    remove(frame_.bounding_box_centers);
+    remove(frame_.bounding_box_dimensions);
+    remove(frame_.bounding_box_poses);
+    remove(is_ego_);
+    if (index < frame_.size()) {
+      indices_[frame_.names[index]] = index;
+    }
+    return true;
+  } else {
+    return false;
+  }
+}
+
+auto EntityTable::clear() -> void
+{
+  frame_ = EntityFrame();
+  is_ego_.clear();
+  indices_.clear();
+}
+
+auto EntityTable::contains(const std::string & name) const -> bool
+{
+  return indices_.find(name) != std::end(indices_);
+}
+
+auto EntityTable::isEgo(const std::string & name) const -> bool
+{
+  if (const auto iter = indices_.find(name); iter != std::end(indices_)) {
+    return is_ego_[iter->second];
+  } else {
+    return false;
+  }
+}
+
+auto EntityTable::update(const simulation_api_schema::EntityStatus & status) -> void
+{
+  assign(
+    indices_.at(status.name()), status.type(), status.subtype(), status.pose(),
+    status.action_status().twist());
+}
+}  // namespace simple_sensor_simulator
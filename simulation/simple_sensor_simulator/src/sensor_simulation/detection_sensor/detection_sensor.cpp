@@ -12,8 +12,6 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <quaternion_operation/quaternion_operation.h>
-
 #include <algorithm>
 #include <autoware_auto_perception_msgs/msg/detected_objects.hpp>
 #include <autoware_auto_perception_msgs/msg/tracked_objects.hpp>
@@ -21,69 +19,65 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_generators.hpp>
 #include <boost/uuid/uuid_io.hpp>
+#include <cstddef>
 #include <geometry/vector3/hypot.hpp>
 #include <memory>
 #include <random>
 #include <simple_sensor_simulator/exception.hpp>
 #include <simple_sensor_simulator/sensor_simulation/detection_sensor/detection_sensor.hpp>
-#include <simulation_interface/conversions.hpp>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
-auto distance(const geometry_msgs::Pose & pose1, const geometry_msgs::Pose & pose2)
+auto distance(const geometry_msgs::msg::Pose & pose1, const geometry_msgs::msg::Pose & pose2)
 {
   return std::hypot(
-    pose1.position().x() - pose2.position().x(),  //
-    pose1.position().y() - pose2.position().y(),  //
-    pose1.position().z() - pose2.position().z());
+    pose1.position.x - pose2.position.x,  //
+    pose1.position.y - pose2.position.y,  //
+    pose1.position.z - pose2.position.z);
 }
 
 auto DetectionSensorBase::isEgoEntityStatusToWhichThisSensorIsAttached(
-  const traffic_simulator_msgs::EntityStatus & status) const -> bool
+  const EntityFrame & entities, std::size_t index) const -> bool
 {
-  return status.name() == configuration_.entity() and
-         status.type().type() == traffic_simulator_msgs::EntityType::EGO;
+  return entities.names[index] == configuration_.entity() and
+         entities.types[index] == traffic_simulator_msgs::EntityType::EGO;
 }
 
 auto DetectionSensorBase::findEgoEntityStatusToWhichThisSensorIsAttached(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & statuses) const
-  -> std::vector<traffic_simulator_msgs::EntityStatus>::const_iterator
+  const EntityFrame & entities) const -> std::size_t
 {
-  if (auto iter = std::find_if(
-        statuses.begin(), statuses.end(),
-        [this](const auto & status) {
-          return isEgoEntityStatusToWhichThisSensorIsAttached(status);
-        });
-      iter != statuses.end()) {
-    return iter;
-  } else {
-    throw SimulationRuntimeError("Detection sensor can be attached only ego entity.");
+  for (std::size_t index = 0; index < entities.size(); ++index) {
+    if (isEgoEntityStatusToWhichThisSensorIsAttached(entities, index)) {
+      return index;
+    }
   }
+  throw SimulationRuntimeError("Detection sensor can be attached only ego entity.");
 }
 
-template <typename To, typename... From>
-auto make(From &&...) -> To;
+template <typename To>
+auto make(const EntityFrame &, std::size_t) -> To;
 
 template <>
-auto make(const traffic_simulator_msgs::EntityStatus & status) -> unique_identifier_msgs::msg::UUID
+auto make(const EntityFrame & entities, std::size_t index) -> unique_identifier_msgs::msg::UUID
 {
   static auto generate_uuid = boost::uuids::name_generator(boost::uuids::random_generator()());
-  const auto uuid = generate_uuid(status.name());
+  const auto uuid = generate_uuid(entities.names[index]);
   unique_identifier_msgs::msg::UUID message;
   std::copy(uuid.begin(), uuid.end(), message.uuid.begin());
   return message;
 }
 
 template <>
-auto make(const traffic_simulator_msgs::EntityStatus & status)
+auto make(const EntityFrame & entities, std::size_t index)
   -> autoware_auto_perception_msgs::msg::ObjectClassification
 {
   auto object_classification = autoware_auto_perception_msgs::msg::ObjectClassification();
 
   object_classification.label = [&]() {
-    switch (status.subtype().value()) {
+    switch (entities.subtypes[index]) {
       case traffic_simulator_msgs::EntitySubtype::CAR:
         return autoware_auto_perception_msgs::msg::ObjectClassification::CAR;
       case traffic_simulator_msgs::EntitySubtype::TRUCK:
@@ -109,39 +103,12 @@ auto make(const traffic_simulator_msgs::EntityStatus & status)
 }
 
 template <>
-auto make(const traffic_simulator_msgs::EntityStatus & status) -> geometry_msgs::msg::Pose
-{
-  auto pose = geometry_msgs::msg::Pose();
-  simulation_interface::toMsg(status.pose(), pose);
-
-  auto center_point = geometry_msgs::msg::Point();
-  simulation_interface::toMsg(status.bounding_box().center(), center_point);
-
-  Eigen::Vector3d center = quaternion_operation::getRotationMatrix(pose.orientation) *
-                           Eigen::Vector3d(center_point.x, center_point.y, center_point.z);
-
-  pose.position.x = pose.position.x + center.x();
-  pose.position.y = pose.position.y + center.y();
-  pose.position.z = pose.position.z + center.z();
-
-  return pose;
-}
-
-template <>
-auto make(const traffic_simulator_msgs::EntityStatus & status) -> geometry_msgs::msg::Twist
-{
-  auto twist = geometry_msgs::msg::Twist();
-  simulation_interface::toMsg(status.action_status().twist(), twist);
-  return twist;
-}
-
-template <>
-auto make(const traffic_simulator_msgs::EntityStatus & status)
+auto make(const EntityFrame & entities, std::size_t index)
   -> autoware_auto_perception_msgs::msg::DetectedObjectKinematics
 {
   auto kinematics = autoware_auto_perception_msgs::msg::DetectedObjectKinematics();
 
-  kinematics.pose_with_covariance.pose = make<geometry_msgs::msg::Pose>(status);
+  kinematics.pose_with_covariance.pose = entities.bounding_box_poses[index];
 
   // clang-format off
   kinematics.pose_with_covariance.covariance = {
@@ -160,10 +127,10 @@ auto make(const traffic_simulator_msgs::EntityStatus & status)
   };
   // clang-format on
 
-  kinematics.twist_with_covariance.twist = make<geometry_msgs::msg::Twist>(status);
+  kinematics.twist_with_covariance.twist = entities.twists[index];
 
   kinematics.orientation_availability = [&]() {
-    switch (status.subtype().value()) {
+    switch (entities.subtypes[index]) {
       case traffic_simulator_msgs::EntitySubtype::BICYCLE:
       case traffic_simulator_msgs::EntitySubtype::MOTORCYCLE:
         return autoware_auto_perception_msgs::msg::DetectedObjectKinematics::SIGN_UNKNOWN;
@@ -176,38 +143,43 @@ auto make(const traffic_simulator_msgs::EntityStatus & status)
 }
 
 template <>
-auto make(const traffic_simulator_msgs::EntityStatus & status)
+auto make(const EntityFrame & entities, std::size_t index)
   -> autoware_auto_perception_msgs::msg::Shape
 {
   auto shape = autoware_auto_perception_msgs::msg::Shape();
-  simulation_interface::toMsg(status.bounding_box().dimensions(), shape.dimensions);
+  shape.dimensions = entities.bounding_box_dimensions[index];
   shape.type = autoware_auto_perception_msgs::msg::Shape::BOUNDING_BOX;
   return shape;
 }
 
 template <>
-auto make(const traffic_simulator_msgs::EntityStatus & status)
+auto make(const EntityFrame & entities, std::size_t index)
   -> autoware_auto_perception_msgs::msg::DetectedObject
 {
   auto detected_object = autoware_auto_perception_msgs::msg::DetectedObject();
   detected_object.classification.push_back(
-    make<autoware_auto_perception_msgs::msg::ObjectClassification>(status));
+    make<autoware_auto_perception_msgs::msg::ObjectClassification>(entities, index));
   detected_object.kinematics =
-    make<autoware_auto_perception_msgs::msg::DetectedObjectKinematics>(status);
-  detected_object.shape = make<autoware_auto_perception_msgs::msg::Shape>(status);
+    make<autoware_auto_perception_msgs::msg::DetectedObjectKinematics>(entities, index);
+  detected_object.shape = make<autoware_auto_perception_msgs::msg::Shape>(entities, index);
   return detected_object;
 }
 
+template <typename To>
+auto make(
+  const EntityFrame &, std::size_t, const autoware_auto_perception_msgs::msg::DetectedObject &)
+  -> To;
+
 template <>
 auto make(
-  const traffic_simulator_msgs::EntityStatus & status,
+  const EntityFrame & entities, std::size_t index,
   const autoware_auto_perception_msgs::msg::DetectedObject & detected_object)
   -> autoware_auto_perception_msgs::msg::TrackedObject
 {
   // ref: https://github.com/autowarefoundation/autoware.universe/blob/main/common/perception_utils/src/conversion.cpp
   auto tracked_object = autoware_auto_perception_msgs::msg::TrackedObject();
   // clang-format off
-  tracked_object.object_id                           = make<unique_identifier_msgs::msg::UUID>(status);
+  tracked_object.object_id                           = make<unique_identifier_msgs::msg::UUID>(entities, index);
   tracked_object.existence_probability               = detected_object.existence_probability;
   tracked_object.classification                      = detected_object.classification;
   tracked_object.kinematics.orientation_availability = detected_object.kinematics.orientation_availability;
@@ -224,7 +196,7 @@ struct DefaultNoiseApplicator
 
   const rclcpp::Time & current_ros_time;
 
-  const traffic_simulator_msgs::EntityStatus & ego_entity_status;
+  const geometry_msgs::msg::Pose & ego_pose;
 
   std::default_random_engine & random_engine;
 
@@ -232,12 +204,11 @@ struct DefaultNoiseApplicator
 
   explicit DefaultNoiseApplicator(
     double current_simulation_time, const rclcpp::Time & current_ros_time,
-    const traffic_simulator_msgs::EntityStatus & ego_entity_status,
-    std::default_random_engine & random_engine,
+    const geometry_msgs::msg::Pose & ego_pose, std::default_random_engine & random_engine,
     const simulation_api_schema::DetectionSensorConfiguration & detection_sensor_configuration)
   : current_simulation_time(current_simulation_time),
     current_ros_time(current_ros_time),
-    ego_entity_status(ego_entity_status),
+    ego_pose(ego_pose),
     random_engine(random_engine),
     detection_sensor_configuration(detection_sensor_configuration)
   {
@@ -251,8 +222,7 @@ struct DefaultNoiseApplicator
 
   auto operator=(DefaultNoiseApplicator &&) = delete;
 
-  auto operator()(autoware_auto_perception_msgs::msg::DetectedObjects detected_objects)
-    -> decltype(auto)
+  auto operator()(autoware_auto_perception_msgs::msg::DetectedObjects & detected_objects) -> void
   {
     auto position_noise_distribution =
       std::normal_distribution<>(0.0, detection_sensor_configuration.pos_noise_stddev());
@@ -272,8 +242,6 @@ struct DefaultNoiseApplicator
                  detection_sensor_configuration.probability_of_lost();
         }),
       detected_objects.objects.end());
-
-    return detected_objects;
   }
 };
 
@@ -286,24 +254,23 @@ struct CustomNoiseApplicator : public DefaultNoiseApplicator
 
      If you need to apply experimental noise to the DetectedObjects that the
      simulator publishes, comment out the following member functions and
-     implement them.
+     implement them. The DetectedObjects are modified in place.
 
      See class DefaultNoiseApplicator for the default noise implementation.
      This class inherits from DefaultNoiseApplicator, so you can use its data
      members, or you can explicitly call DefaultNoiseApplicator::operator().
   */
-  // auto operator()(autoware_auto_perception_msgs::msg::DetectedObjects detected_objects)
-  //   -> decltype(auto)
+  // auto operator()(autoware_auto_perception_msgs::msg::DetectedObjects & detected_objects)
+  //   -> void
   // {
-  //   return detected_objects;
   // }
 };
 
 template <>
 auto DetectionSensor<autoware_auto_perception_msgs::msg::DetectedObjects>::update(
   const double current_simulation_time,
-  const std::vector<traffic_simulator_msgs::EntityStatus> & statuses,
-  const rclcpp::Time & current_ros_time, const std::vector<std::string> & lidar_detected_entities)
+  const EntityFrame & entities, const rclcpp::Time & current_ros_time,
+  const std::vector<bool> & lidar_detected_entities)
   -> void
 {
   if (
@@ -311,48 +278,63 @@ auto DetectionSensor<autoware_auto_perception_msgs::msg::DetectedObjects>::updat
     -0.002) {
     previous_simulation_time_ = current_simulation_time;
 
-    autoware_auto_perception_msgs::msg::DetectedObjects detected_objects;
+    const auto & ego_pose =
+      entities.poses[findEgoEntityStatusToWhichThisSensorIsAttached(entities)];
+
+    /*
+       NOTE: The slots are filled in place and enqueued only once both
+       messages are complete, so an exception thrown on the way never leaves
+       a partially built message in the queues.
+    */
+    auto & detected_objects = detected_objects_queue.next();
     detected_objects.header.stamp = current_ros_time;
     detected_objects.header.frame_id = "map";
+    detected_objects.objects.clear();
 
-    autoware_auto_perception_msgs::msg::TrackedObjects ground_truth_objects;
+    auto & ground_truth_objects = ground_truth_objects_queue.next();
     ground_truth_objects.header = detected_objects.header;
+    ground_truth_objects.objects.clear();
 
-    const auto ego_entity_status = findEgoEntityStatusToWhichThisSensorIsAttached(statuses);
-
-    auto is_in_range = [&](const auto & status) {
-      return not isEgoEntityStatusToWhichThisSensorIsAttached(status) and
-             distance(status.pose(), ego_entity_status->pose()) <= configuration_.range() and
-             (configuration_.detect_all_objects_in_range() or
-              std::find(
-                lidar_detected_entities.begin(), lidar_detected_entities.end(), status.name()) !=
-                lidar_detected_entities.end());
+    auto is_in_range = [&](std::size_t index) {
+      return not isEgoEntityStatusToWhichThisSensorIsAttached(entities, index) and
+             distance(entities.poses[index], ego_pose) <= configuration_.range() and
+             (configuration_.detect_all_objects_in_range() or lidar_detected_entities[index]);
     };
 
-    for (const auto & status : statuses) {
-      if (is_in_range(status)) {
+    for (std::size_t index = 0; index < entities.size(); ++index) {
+      if (is_in_range(index)) {
         const auto detected_object =
-          make<autoware_auto_perception_msgs::msg::DetectedObject>(status);
+          make<autoware_auto_perception_msgs::msg::DetectedObject>(entities, index);
         detected_objects.objects.push_back(detected_object);
         ground_truth_objects.objects.push_back(
-          make<autoware_auto_perception_msgs::msg::TrackedObject>(status, detected_object));
+          make<autoware_auto_perception_msgs::msg::TrackedObject>(
+            entities, index, detected_object));
       }
     }
 
-    if (detected_objects_queue.emplace(detected_objects, current_simulation_time);
-        current_simulation_time - detected_objects_queue.front().second >=
-        configuration_.object_recognition_delay()) {
-      auto apply_noise = CustomNoiseApplicator(
-        current_simulation_time, current_ros_time, *ego_entity_status, random_engine_,
-        configuration_);
-      detected_objects_publisher->publish(apply_noise(detected_objects_queue.front().first));
+    detected_objects_queue.push(current_simulation_time);
+    ground_truth_objects_queue.push(current_simulation_time);
+
+    if (
+      current_simulation_time - detected_objects_queue.frontTime() >=
+      configuration_.object_recognition_delay()) {
+      /*
+         NOTE: Moving the message out of its slot would take the capacity of
+         the slot with it, so the message is copied into (the capacity of)
+         noisy_detected_objects_ instead, and the noise is applied to the copy.
+      */
+      noisy_detected_objects_ = detected_objects_queue.front();
       detected_objects_queue.pop();
+      auto apply_noise = CustomNoiseApplicator(
+        current_simulation_time, current_ros_time, ego_pose, random_engine_, configuration_);
+      apply_noise(noisy_detected_objects_);
+      detected_objects_publisher->publish(noisy_detected_objects_);
     }
 
-    if (ground_truth_objects_queue.emplace(ground_truth_objects, current_simulation_time);
-        current_simulation_time - ground_truth_objects_queue.front().second >=
-        configuration_.object_recognition_ground_truth_delay()) {
-      ground_truth_objects_publisher->publish(ground_truth_objects_queue.front().first);
+    if (
+      current_simulation_time - ground_truth_objects_queue.frontTime() >=
+      configuration_.object_recognition_ground_truth_delay()) {
+      ground_truth_objects_publisher->publish(ground_truth_objects_queue.front());
       ground_truth_objects_queue.pop();
     }
   }
@@ -12,13 +12,11 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <quaternion_operation/quaternion_operation.h>
-
+#include <cstddef>
 #include <memory>
 #include <optional>
 #include <simple_sensor_simulator/exception.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
-#include <simulation_interface/conversions.hpp>
 #include <string>
 #include <vector>
 
@@ -26,44 +24,31 @@ namespace simple_sensor_simulator
 {
 template <>
 auto LidarSensor<sensor_msgs::msg::PointCloud2>::raycast(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
-  const rclcpp::Time & current_ros_time) -> sensor_msgs::msg::PointCloud2
+  const EntityFrame & entities, const rclcpp::Time & current_ros_time,
+  sensor_msgs::msg::PointCloud2 & pointcloud) -> void
 {
-  std::optional<geometry_msgs::msg::Pose> ego_pose;
+  std::optional<std::size_t> ego_index;
 
-  for (const auto & entity : entities) {
-    if (configuration_.entity() == entity.name()) {
-      geometry_msgs::msg::Pose pose;
-      simulation_interface::toMsg(entity.pose(), pose);
-      ego_pose = pose;
-    } else {
-      geometry_msgs::msg::Pose pose;
-      simulation_interface::toMsg(entity.pose(), pose);
-      auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
-      geometry_msgs::msg::Point center_point;
-      simulation_interface::toMsg(entity.bounding_box().center(), center_point);
-      Eigen::Vector3d center(center_point.x, center_point.y, center_point.z);
-      center = rotation * center;
-      pose.position.x = pose.position.x + center.x();
-      pose.position.y = pose.position.y + center.y();
-      pose.position.z = pose.position.z + center.z();
-      raycaster_.addPrimitive<simple_sensor_simulator::primitives::Box>(
-        entity.name(),                           //
-        entity.bounding_box().dimensions().x(),  //
-        entity.bounding_box().dimensions().y(),  //
-        entity.bounding_box().dimensions().z(),  //
-        pose);
+  for (std::size_t i = 0; i < entities.size() and not ego_index; ++i) {
+    if (configuration_.entity() == entities.names[i]) {
+      ego_index = i;
     }
   }
 
-  if (ego_pose) {
-    std::vector<double> vertical_angles;
-    for (const auto vertical_angle : configuration_.vertical_angles()) {
-      vertical_angles.push_back(vertical_angle);
+  if (ego_index) {
+    for (std::size_t i = 0; i < entities.size(); ++i) {
+      if (i != ego_index.value()) {
+        raycaster_.addPrimitive<simple_sensor_simulator::primitives::Box>(
+          i,                                      //
+          entities.bounding_box_dimensions[i].x,  //
+          entities.bounding_box_dimensions[i].y,  //
+          entities.bounding_box_dimensions[i].z,  //
+          entities.bounding_box_poses[i]);
+      }
     }
-    const auto pointcloud = raycaster_.raycast("base_link", current_ros_time, ego_pose.value());
+    raycaster_.raycast(
+      "base_link", current_ros_time, entities.poses[ego_index.value()], pointcloud);
     detected_objects_ = raycaster_.getDetectedObject();
-    return pointcloud;
   } else {
     throw simple_sensor_simulator::SimulationRuntimeError("failed to find ego vehicle");
   }
@@ -15,26 +15,28 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstring>
 #include <iostream>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/lidar_sensor.hpp>
 #include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
 #include <string>
-#include <unordered_map>
 #include <utility>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
-Raycaster::Raycaster()
-: primitive_ptrs_(0),
+Raycaster::Raycaster(WorkerPool & worker_pool)
+: worker_pool_(worker_pool),
   device_(rtcNewDevice(nullptr)),
   scene_(rtcNewScene(device_)),
   engine_(seed_gen_())
 {
 }
 
-Raycaster::Raycaster(std::string embree_config)
-: primitive_ptrs_(0),
+Raycaster::Raycaster(WorkerPool & worker_pool, std::string embree_config)
+: worker_pool_(worker_pool),
   device_(rtcNewDevice(embree_config.c_str())),
   scene_(rtcNewScene(device_)),
   engine_(seed_gen_())
@@ -44,9 +46,30 @@ Raycaster::Raycaster(std::string embree_config)
 Raycaster::~Raycaster()
 {
   rtcReleaseScene(scene_);
+  if (static_scene_) {
+    rtcReleaseScene(static_scene_);
+  }
   rtcReleaseDevice(device_);
 }
 
+void Raycaster::addStaticPrimitive(const primitives::Primitive & primitive)
+{
+  if (not static_scene_) {
+    static_scene_ = rtcNewScene(device_);
+    RTCGeometry instance = rtcNewGeometry(device_, RTC_GEOMETRY_TYPE_INSTANCE);
+    rtcSetGeometryInstancedScene(instance, static_scene_);
+    const float identity[12] = {1, 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 0};
+    rtcSetGeometryTransform(instance, 0, RTC_FORMAT_FLOAT3X4_COLUMN_MAJOR, identity);
+    // enable raycasting
+    rtcSetGeometryMask(instance, 0b11111111'11111111'11111111'11111111);
+    rtcCommitGeometry(instance);
+    rtcAttachGeometry(scene_, instance);
+    rtcReleaseGeometry(instance);
+  }
+  primitive.addToScene(device_, static_scene_);
+  rtcCommitScene(static_scene_);
+}
+
 void Raycaster::setDirection(
   const simulation_api_schema::LidarConfiguration & configuration, double horizontal_angle_start,
   double horizontal_angle_end)
@@ -96,56 +119,78 @@ std::vector<geometry_msgs::msg::Quaternion> Raycaster::getDirections(
   return directions_;
 }
 
-const std::vector<std::string> & Raycaster::getDetectedObject() const { return detected_objects_; }
+const std::vector<std::size_t> & Raycaster::getDetectedObject() const { return detected_objects_; }
 
-const sensor_msgs::msg::PointCloud2 Raycaster::raycast(
+void Raycaster::raycast(
   const std::string & frame_id, const rclcpp::Time & stamp, const geometry_msgs::msg::Pose & origin,
-  double max_distance, double min_distance)
+  sensor_msgs::msg::PointCloud2 & pointcloud_msg, double max_distance, double min_distance)
 {
-  detected_objects_ = {};
-  pcl::PointCloud<pcl::PointXYZI>::Ptr cloud(new pcl::PointCloud<pcl::PointXYZI>());
-  for (auto & pair : primitive_ptrs_) {
-    auto id = pair.second->addToScene(device_, scene_);
-    geometry_ids_.insert({id, pair.first});
+  detected_objects_.clear();
+  // Embree assigns geometry IDs from 0 (reusing those of detached geometries)
+  std::vector<unsigned int> geometry_ids;
+  std::vector<std::size_t> primitive_ids;
+  for (auto & [primitive_id, primitive_ptr] : primitive_ptrs_) {
+    const auto geometry_id = primitive_ptr->addToScene(device_, scene_);
+    geometry_ids.push_back(geometry_id);
+    if (primitive_ids.size() <= geometry_id) {
+      primitive_ids.resize(geometry_id + 1);
+    }
+    primitive_ids[geometry_id] = primitive_id;
   }
 
-  // Run as many threads as physical cores (which is usually /2 virtual threads)
-  // In heavy loads virtual threads (hyper-threading) add little to the overall performance
-  // This also minimizes cost of creating a thread (roughly 10us on Intel/Linux)
-  int thread_count = std::thread::hardware_concurrency() / 2;
-  // Per thread data structures:
-  std::vector<std::thread> threads(thread_count);
-  std::vector<std::set<unsigned int>> thread_detected_ids(thread_count);
-  std::vector<pcl::PointCloud<pcl::PointXYZI>::Ptr> thread_cloud(thread_count);
+  // Split the directions into as many workers as the threads of the shared pool, so that
+  // the points are in the same order whichever threads run the workers
+  const int worker_count = worker_pool_.size();
+  // Per worker data structures:
+  std::vector<std::vector<bool>> thread_detected_ids(
+    worker_count, std::vector<bool>(primitive_ids.size(), false));
+  thread_points_.resize(worker_count);
 
   rtcCommitScene(scene_);
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    thread_cloud[i] = pcl::PointCloud<pcl::PointXYZI>::Ptr(new pcl::PointCloud<pcl::PointXYZI>());
-    threads[i] = std::thread(
-      intersect, i, thread_count, scene_, thread_cloud[i], origin, std::ref(thread_detected_ids[i]),
-      max_distance, min_distance, std::ref(rotation_matrices_));
+  worker_pool_.run(worker_count, [&](std::size_t i) {
+    thread_points_[i].clear();
+    intersect(
+      i, worker_count, scene_, std::ref(thread_points_[i]), origin,
+      std::ref(thread_detected_ids[i]), max_distance, min_distance, std::ref(rotation_matrices_));
+  });
+  std::size_t point_count = 0;
+  for (const auto & points : thread_points_) {
+    point_count += points.size() / 4;
   }
-  for (unsigned int i = 0; i < threads.size(); ++i) {
-    threads[i].join();
-    (*cloud) += *(thread_cloud[i]);
-  }
-  for (auto && detected_ids_in_thread : thread_detected_ids) {
-    for (const auto & id : detected_ids_in_thread) {
-      detected_objects_.emplace_back(geometry_ids_[id]);
+  for (const auto geometry_id : geometry_ids) {
+    if (std::any_of(
+          thread_detected_ids.begin(), thread_detected_ids.end(),
+          [&](const auto & detected_ids) { return detected_ids[geometry_id]; })) {
+      detected_objects_.push_back(primitive_ids[geometry_id]);
     }
   }
 
-  for (const auto & id : geometry_ids_) {
-    rtcDetachGeometry(scene_, id.first);
+  for (const auto geometry_id : geometry_ids) {
+    rtcDetachGeometry(scene_, geometry_id);
   }
 
-  geometry_ids_.clear();
   primitive_ptrs_.clear();
 
-  sensor_msgs::msg::PointCloud2 pointcloud_msg;
-  pcl::toROSMsg(*cloud, pointcloud_msg);
+  /*
+     Write the points straight into the data of pointcloud_msg (reusing its
+     capacity) as packed x, y, z and intensity, instead of building a
+     pcl::PointCloud<pcl::PointXYZI> and converting it. This also halves the
+     size of the message, since PointXYZI is padded to 32 bytes per point.
+  */
+  sensor_msgs::PointCloud2Modifier modifier(pointcloud_msg);
+  modifier.setPointCloud2Fields(
+    4, "x", 1, sensor_msgs::msg::PointField::FLOAT32, "y", 1, sensor_msgs::msg::PointField::FLOAT32,
+    "z", 1, sensor_msgs::msg::PointField::FLOAT32, "intensity", 1,
+    sensor_msgs::msg::PointField::FLOAT32);
+  modifier.resize(point_count);
+  auto data = pointcloud_msg.data.data();
+  for (const auto & points : thread_points_) {
+    std::memcpy(data, points.data(), points.size() * sizeof(float));
+    data += points.size() * sizeof(float);
+  }
   pointcloud_msg.header.frame_id = frame_id;
   pointcloud_msg.header.stamp = stamp;
-  return pointcloud_msg;
+  pointcloud_msg.is_bigendian = false;
+  pointcloud_msg.is_dense = true;
 }
 }  // namespace simple_sensor_simulator
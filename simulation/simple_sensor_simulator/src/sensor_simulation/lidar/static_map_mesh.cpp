@@ -0,0 +1,125 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <cstddef>
+#include <simple_sensor_simulator/sensor_simulation/lidar/static_map_mesh.hpp>
+#include <utility>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace
+{
+auto toVertex(const lanelet::BasicPoint3d & point, double z_offset = 0) -> Vertex
+{
+  return {
+    static_cast<float>(point.x()), static_cast<float>(point.y()),
+    static_cast<float>(point.z() + z_offset)};
+}
+
+auto toVertex(const lanelet::ConstPoint3d & point) -> Vertex
+{
+  return toVertex(point.basicPoint());
+}
+
+auto squaredDistance(const lanelet::ConstPoint3d & a, const lanelet::ConstPoint3d & b)
+{
+  return (a.basicPoint() - b.basicPoint()).squaredNorm();
+}
+
+/*
+   Triangulates the strip between two polylines by advancing along whichever
+   of them gives the shorter diagonal.
+*/
+auto triangulateStrip(
+  const lanelet::ConstLineString3d & left, const lanelet::ConstLineString3d & right,
+  std::vector<Vertex> & vertices, std::vector<Triangle> & triangles) -> void
+{
+  if (left.size() == 0 or right.size() == 0 or left.size() + right.size() < 3) {
+    return;
+  }
+
+  const auto l = static_cast<unsigned int>(vertices.size());
+  for (const auto & point : left) {
+    vertices.push_back(toVertex(point));
+  }
+
+  const auto r = static_cast<unsigned int>(vertices.size());
+  for (const auto & point : right) {
+    vertices.push_back(toVertex(point));
+  }
+
+  for (std::size_t i = 0, j = 0; i + 1 < left.size() or j + 1 < right.size();) {
+    if (
+      j + 1 == right.size() or
+      (i + 1 < left.size() and
+       squaredDistance(left[i + 1], right[j]) <= squaredDistance(left[i], right[j + 1]))) {
+      triangles.push_back({l + unsigned(i), r + unsigned(j), l + unsigned(i + 1)});
+      ++i;
+    } else {
+      triangles.push_back({l + unsigned(i), r + unsigned(j), r + unsigned(j + 1)});
+      ++j;
+    }
+  }
+}
+
+/*
+   Extrudes every edge of the polygon (which is implicitly closed) upwards by
+   the given height. Edges of zero length (e.g. the closing edge of a polygon
+   that repeats its first point at the end) are skipped, since they would
+   only give degenerate triangles.
+*/
+auto extrude(
+  const lanelet::BasicPolygon3d & polygon, double height, std::vector<Vertex> & vertices,
+  std::vector<Triangle> & triangles) -> void
+{
+  for (std::size_t i = 0; i < polygon.size(); ++i) {
+    const auto & p = polygon[i];
+    const auto & q = polygon[(i + 1) % polygon.size()];
+    if (p != q) {
+      const auto v = static_cast<unsigned int>(vertices.size());
+      vertices.push_back(toVertex(p));
+      vertices.push_back(toVertex(q));
+      vertices.push_back(toVertex(p, height));
+      vertices.push_back(toVertex(q, height));
+      triangles.push_back({v + 0, v + 1, v + 2});
+      triangles.push_back({v + 1, v + 3, v + 2});
+    }
+  }
+}
+}  // namespace
+
+auto makeStaticMapMesh(const lanelet::LaneletMapConstPtr & lanelet_map) -> primitives::Mesh
+{
+  std::vector<Vertex> vertices;
+  std::vector<Triangle> triangles;
+
+  for (const auto & lanelet : lanelet_map->laneletLayer) {
+    triangulateStrip(lanelet.leftBound3d(), lanelet.rightBound3d(), vertices, triangles);
+  }
+
+  for (const auto & area : lanelet_map->areaLayer) {
+    if (const auto height = area.attributeOr("height", 0.0); 0 < height) {
+      /*
+         NOTE: The outer bound may consist of several linestrings, none of
+         which is closed by itself, so their points are joined into a single
+         polygon first.
+      */
+      extrude(area.outerBoundPolygon().basicPolygon(), height, vertices, triangles);
+    }
+  }
+
+  return primitives::Mesh(std::move(vertices), std::move(triangles));
+}
+}  // namespace simple_sensor_simulator
@@ -14,15 +14,38 @@
 
 #include <quaternion_operation/quaternion_operation.h>
 
+#include <algorithm>
 #include <boost/geometry.hpp>
 #include <rclcpp/rclcpp.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/grid_traversal.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_builder.hpp>
+#include <utility>
+#include <vector>
 
 namespace simple_sensor_simulator
 {
+namespace
+{
+/*
+   Calls f(i, worker_id) for each i in [0, size), the worker worker_id of
+   worker_count taking every worker_count-th i from worker_id. The workers
+   are run on the pool, so the partition of [0, size) and the working memory
+   each i is processed with depend on worker_count only.
+*/
+template <typename F>
+auto forEachConcurrently(WorkerPool & worker_pool, size_t size, size_t worker_count, F f) -> void
+{
+  worker_pool.run(std::min(size, worker_count), [&](size_t worker_id) {
+    for (auto i = worker_id; i < size; i += worker_count) {
+      f(i, worker_id);
+    }
+  });
+}
+}  // namespace
+
 OccupancyGridBuilder::OccupancyGridBuilder(
-  double resolution, size_t height, size_t width, int8_t occupied_cost, int8_t invisible_cost)
+  WorkerPool & worker_pool, double resolution, size_t height, size_t width, int8_t occupied_cost,
+  int8_t invisible_cost)
 : resolution(resolution),
   height(height),
   width(width),
@@ -30,12 +53,19 @@ OccupancyGridBuilder::OccupancyGridBuilder(
   occupied_cost(occupied_cost),
   invisible_cost(invisible_cost),
 
+  dirty_rows_(height),
+
+  worker_pool_(worker_pool),
+
+  // Split the work for as many threads as the pool has, as Raycaster does
+  worker_count_(worker_pool.size()),
+
   occupied_grid_(height * width),
   invisible_grid_(height * width),
   values_(height * width),
 
-  min_cols_(height),
-  max_cols_(height)
+  min_cols_(worker_count_, std::vector<int32_t>(height, width)),
+  max_cols_(worker_count_, std::vector<int32_t>(height, -1))
 {
 }
 
@@ -64,7 +94,7 @@ auto OccupancyGridBuilder::makePoint(double x, double y, double z) const -> Poin
   return res;
 }
 
-auto OccupancyGridBuilder::makeOccupiedArea(const PrimitiveType & primitive) const -> PolygonType
+auto OccupancyGridBuilder::makeOccupiedArea(const PolygonType & convex_hull) const -> PolygonType
 {
   namespace bg = boost::geometry;
   using Point = bg::model::d2::point_xy<double>;
@@ -72,7 +102,7 @@ auto OccupancyGridBuilder::makeOccupiedArea(const PrimitiveType & primitive) con
 
   // Generate a polygon of given primitive
   auto primitive_ring = Ring();
-  for (auto & e : primitive.get2DConvexHull()) {
+  for (auto & e : convex_hull) {
     auto p = transformToGrid(e);
     primitive_ring.emplace_back(p.x, p.y);
   }
@@ -192,49 +222,66 @@ auto OccupancyGridBuilder::makeInvisibleArea(const PolygonType & occupied_polygo
   return res;
 }
 
-auto OccupancyGridBuilder::addPolygon(MarkerGridType & grid, const PolygonType & convex_hull)
-  -> void
+auto OccupancyGridBuilder::rasterize(
+  const PolygonType & convex_hull, SpansType & spans, size_t worker_id) -> void
 {
   // This function assumes a given polygon is a convex hull and marks only edges
   // of the polygon. This makes performance of an occupancy grid generation
   // tolerant of an increasing number of primitives.
 
-  min_cols_.assign(min_cols_.size(), width);  // Leftmost marked cells of each rows
-  max_cols_.assign(max_cols_.size(), -1);     // Rightmost marked cells of each rows
+  spans.clear();
+
+  auto & min_cols = min_cols_[worker_id];
+  auto & max_cols = max_cols_[worker_id];
 
-  // Traverse each polygon edges on grid coordinate and update `min_cols_` and `max_cols_`
+  // `min_cols` and `max_cols_` hold the leftmost and the rightmost marked
+  // cells of each rows, and are restored to `width` and `-1` before returning
+  auto min_row = int32_t(height);
+  auto max_row = int32_t(-1);
+
+  // Traverse each polygon edges on grid coordinate and update `min_cols` and `max_cols`
   for (size_t i = 0; i < convex_hull.size(); ++i) {
     const auto p = transformToPixel(convex_hull[i]);
     const auto q = transformToPixel(convex_hull[(i + 1) % convex_hull.size()]);
     for (auto [col, row] : GridTraversal(p.x, p.y, q.x, q.y)) {
       if (row >= 0 && row < int32_t(height)) {
-        min_cols_[row] = std::min(min_cols_[row], col);
-        max_cols_[row] = std::max(max_cols_[row], col);
+        min_cols[row] = std::min(min_cols[row], col);
+        max_cols[row] = std::max(max_cols[row], col);
+        min_row = std::min(min_row, row);
+        max_row = std::max(max_row, row);
       }
     }
   }
 
-  // Put marked cells on the occupancy grid
-  for (size_t row = 0; row < height; ++row) {
-    auto min_col = min_cols_[row];
-    auto max_col = max_cols_[row] + 1;
+  for (auto row = min_row; row <= max_row; ++row) {
+    auto min_col = min_cols[row];
+    auto max_col = max_cols[row] + 1;
+
+    min_cols[row] = int32_t(width);
+    max_cols[row] = -1;
 
     // do not care the outside of the occupancy grid
     if (max_col <= 0 || min_col >= int32_t(width)) {
       continue;
     }
 
+    spans.push_back({row, std::max(min_col, 0), std::min(max_col, int32_t(width))});
+  }
+}
+
+auto OccupancyGridBuilder::mark(
+  MarkerGridType & grid, const SpansType & spans, MarkerCounterType delta) -> void
+{
+  for (const auto & span : spans) {
     // Increment the leftmost grid cell values
-    if (min_col <= 0) {
-      ++grid[width * row];
-    } else {
-      ++grid[width * row + min_col];
-    }
+    grid[width * span.row + span.begin] += delta;
 
-    // Decrement the leftmost grid cell values
-    if (max_col < int32_t(width)) {
-      --grid[width * row + max_col];
+    // Decrement the cell values right after the rightmost ones
+    if (span.end < int32_t(width)) {
+      grid[width * span.row + span.end] -= delta;
     }
+
+    dirty_rows_[span.row] = true;
   }
 
   // At this stage, we have marked grid cells like
@@ -255,48 +302,121 @@ auto OccupancyGridBuilder::addPolygon(MarkerGridType & grid, const PolygonType &
 
 auto OccupancyGridBuilder::add(const PrimitiveType & primitive) -> void
 {
-  {
-    constexpr auto count_max = std::numeric_limits<MarkerCounterType>::max();
-    if (primitive_count_++ == count_max) {
-      throw std::runtime_error(
-        "Grid cannot hold more than " + std::to_string(count_max) + " primitives");
-    }
-  }
+  add(primitive.get2DConvexHull());
+}
 
-  auto occupied_area = makeOccupiedArea(primitive);
+auto OccupancyGridBuilder::add(const PolygonType & convex_hull) -> void
+{
+  add(convex_hull, primitive_count_);
+}
 
-  auto invisible_area = makeInvisibleArea(occupied_area);
+auto OccupancyGridBuilder::add(const PolygonType & convex_hull, size_t id) -> void
+{
+  constexpr auto count_max = std::numeric_limits<MarkerCounterType>::max();
+  if (primitive_count_ == count_max) {
+    throw std::runtime_error(
+      "Grid cannot hold more than " + std::to_string(count_max) + " primitives");
+  }
+
+  if (footprints_.size() <= id) {
+    footprints_.resize(id + 1);
+  }
 
-  // mark invisible area
-  addPolygon(invisible_grid_, invisible_area);
+  auto & footprint = footprints_[id];
+  if (footprint.is_added) {
+    throw std::runtime_error("Primitive " + std::to_string(id) + " is added twice");
+  }
 
-  // mark occupied area
-  addPolygon(occupied_grid_, occupied_area);
+  // Compare with the convex hull of the same id only, rather than with every footprint
+  if (not footprint.is_marked or footprint.convex_hull != convex_hull) {
+    footprint.convex_hull.assign(convex_hull.begin(), convex_hull.end());
+    footprint.is_changed = true;
+  }
+  footprint.is_added = true;
+  ++primitive_count_;
 }
 
-auto OccupancyGridBuilder::build() -> void
+auto OccupancyGridBuilder::build() -> size_t
 {
-  // https://imoz.jp/algorithms/imos_method.html (Japanese)
-
-  // We can make prefix sum calculation faster by unrolling for loop and
-  // tweaking compiler options, but, as far as I run this code locally,
-  // it takes about 200us for 400x400 grids and I think it is sufficient,
-  // so I leave this naive implementation.
-  for (size_t row = 0; row < height; ++row) {
-    for (size_t col = 0; col + 1 < width; ++col) {
-      invisible_grid_[row * width + col + 1] += invisible_grid_[row * width + col];
+  // Every primitive moves on the grid if the origin moves, so start over
+  if (built_origin_ != origin_) {
+    built_origin_ = origin_;
+    invisible_grid_.assign(invisible_grid_.size(), 0);
+    occupied_grid_.assign(occupied_grid_.size(), 0);
+    dirty_rows_.assign(dirty_rows_.size(), true);
+    for (auto & footprint : footprints_) {
+      footprint.is_marked = false;
     }
   }
 
-  for (size_t row = 0; row < height; ++row) {
-    for (size_t col = 0; col + 1 < width; ++col) {
-      occupied_grid_[row * width + col + 1] += occupied_grid_[row * width + col];
+  // Keep the footprints of primitives added again unchanged, unmark the others,
+  // and rasterize the primitives newly added or changed, each into its own footprint
+  rasterized_ids_.clear();
+  for (size_t id = 0; id < footprints_.size(); ++id) {
+    auto & footprint = footprints_[id];
+    if (footprint.is_marked and (footprint.is_changed or not footprint.is_added)) {
+      mark(invisible_grid_, footprint.invisible_spans, -1);
+      mark(occupied_grid_, footprint.occupied_spans, -1);
+      footprint.is_marked = false;
+    }
+    if (footprint.is_added and not footprint.is_marked) {
+      rasterized_ids_.push_back(id);
     }
   }
 
-  for (size_t i = 0; i < height * width; ++i) {
-    values_[i] = occupied_grid_[i] ? occupied_cost : invisible_grid_[i] ? invisible_cost : 0;
+  forEachConcurrently(
+    worker_pool_, rasterized_ids_.size(), worker_count_, [&](size_t i, size_t worker_id) {
+      auto & footprint = footprints_[rasterized_ids_[i]];
+
+      auto occupied_area = makeOccupiedArea(footprint.convex_hull);
+
+      auto invisible_area = makeInvisibleArea(occupied_area);
+
+      rasterize(invisible_area, footprint.invisible_spans, worker_id);
+
+      rasterize(occupied_area, footprint.occupied_spans, worker_id);
+    });
+
+  // Mark them on the grids, which gives the same markers in any order
+  for (const auto id : rasterized_ids_) {
+    auto & footprint = footprints_[id];
+
+    // mark invisible area
+    mark(invisible_grid_, footprint.invisible_spans, 1);
+
+    // mark occupied area
+    mark(occupied_grid_, footprint.occupied_spans, 1);
+
+    footprint.is_marked = true;
+    footprint.is_changed = false;
   }
+
+  // https://imoz.jp/algorithms/imos_method.html (Japanese)
+
+  // Calculate prefix sums of the rows changed since the previous build only,
+  // each worker taking a contiguous block of rows. The grids hold differences
+  // rather than prefix sums so that they can be updated incrementally.
+  const auto dirty = std::find(dirty_rows_.begin(), dirty_rows_.end(), true) != dirty_rows_.end();
+  forEachConcurrently(
+    worker_pool_, dirty ? worker_count_ : 0, worker_count_, [&](size_t block, size_t) {
+      for (auto row = height * block / worker_count_; row < height * (block + 1) / worker_count_;
+           ++row) {
+        if (dirty_rows_[row]) {
+          MarkerCounterType invisible = 0;
+          MarkerCounterType occupied = 0;
+          for (size_t col = 0; col < width; ++col) {
+            invisible += invisible_grid_[row * width + col];
+            occupied += occupied_grid_[row * width + col];
+            values_[row * width + col] = occupied ? occupied_cost : invisible ? invisible_cost : 0;
+          }
+        }
+      }
+    });
+
+  // NOTE: not cleared by the threads above, as std::vector<bool> packs flags of rows into words
+  dirty_rows_.assign(dirty_rows_.size(), false);
+
+  return rasterized_ids_.size();
 }
 
 auto OccupancyGridBuilder::get() const -> const OccupancyGridType & { return values_; }
@@ -305,8 +425,9 @@ auto OccupancyGridBuilder::reset(const PoseType & origin) -> void
 {
   origin_ = origin;
   primitive_count_ = 0;
-  invisible_grid_.assign(invisible_grid_.size(), 0);
-  occupied_grid_.assign(occupied_grid_.size(), 0);
+  for (auto & footprint : footprints_) {
+    footprint.is_added = false;
+  }
 }
 
 }  // namespace simple_sensor_simulator
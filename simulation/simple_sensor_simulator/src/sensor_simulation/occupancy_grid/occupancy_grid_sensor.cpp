@@ -12,85 +12,68 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
-#include <quaternion_operation/quaternion_operation.h>
-
 #include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <memory>
 #include <nav_msgs/msg/occupancy_grid.hpp>
 #include <optional>
 #include <simple_sensor_simulator/exception.hpp>
 #include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
-#include <simulation_interface/conversions.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
 #include <string>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
-geometry_msgs::Pose OccupancyGridSensorBase::getSensorPose(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & status) const
+const geometry_msgs::msg::Pose & OccupancyGridSensorBase::getSensorPose(
+  const EntityFrame & entities) const
 {
-  for (const auto & s : status) {
+  for (std::size_t i = 0; i < entities.size(); ++i) {
     if (
-      s.type().type() == traffic_simulator_msgs::EntityType::EGO &&
-      s.name() == configuration_.entity()) {
-      return s.pose();
+      entities.types[i] == traffic_simulator_msgs::EntityType::EGO &&
+      entities.names[i] == configuration_.entity()) {
+      return entities.poses[i];
     }
   }
   throw SimulationRuntimeError("Occupancy grid sensor can be attached only ego entity.");
 }
 
-const std::vector<std::string> OccupancyGridSensorBase::getDetectedObjects(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & status,
-  const std::vector<std::string> & lidar_detected_entities) const
+void OccupancyGridSensorBase::getDetectedObjects(
+  const EntityFrame & entities, const std::vector<bool> & lidar_detected_entities,
+  std::vector<bool> & detected_entities) const
 {
-  std::vector<std::string> detected_entities;
-  const auto pose = getSensorPose(status);
-  for (const auto & s : status) {
-    if (const auto has_detected =
-          std::find(lidar_detected_entities.begin(), lidar_detected_entities.end(), s.name()) !=
-          lidar_detected_entities.end();
-        !has_detected) {
+  detected_entities.assign(entities.size(), false);
+  const auto & pose = getSensorPose(entities);
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    if (!lidar_detected_entities[i]) {
       continue;
     }
 
+    const auto & position = entities.poses[i].position;
     double distance = std::hypot(
-      s.pose().position().x() - pose.position().x(), s.pose().position().y() - pose.position().y(),
-      s.pose().position().z() - pose.position().z());
-    if (s.name() != configuration_.entity() && distance <= configuration_.range()) {
-      detected_entities.emplace_back(s.name());
+      position.x - pose.position.x, position.y - pose.position.y, position.z - pose.position.z);
+    if (entities.names[i] != configuration_.entity() && distance <= configuration_.range()) {
+      detected_entities[i] = true;
     }
   }
-  return detected_entities;
 }
 
 template <>
 auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
-  const std::vector<traffic_simulator_msgs::EntityStatus> & status, const rclcpp::Time & stamp,
-  const std::vector<std::string> & lidar_detected_entities) -> nav_msgs::msg::OccupancyGrid
+  const EntityFrame & entities, const rclcpp::Time & stamp,
+  const std::vector<bool> & lidar_detected_entities) -> const nav_msgs::msg::OccupancyGrid &
 {
-  // check if entities in `status` have unique names
-  {
-    auto unique_entities = std::set<std::string>();
-    for (const auto & s : status) {
-      if (configuration_.entity() != s.name()) {
-        if (unique_entities.count(s.name()) != 0) {
-          throw std::runtime_error(
-            "status contains primitives with the same name: `" + s.name() + "`");
-        }
-        unique_entities.insert(s.name());
-      }
-    }
-  }
+  // NOTE: names in `entities` are unique because EntityTable is keyed by name
 
-  // find ego from `status` and get its pose with north side up
+  // find ego from `entities` and get its pose with north side up
   auto ego_pose_north_up = geometry_msgs::msg::Pose();
   {
-    auto is_ego = [&](const auto & s) { return configuration_.entity() == s.name(); };
-    auto ego = std::find_if(status.begin(), status.end(), is_ego);
-    if (ego == status.end()) {
+    auto ego = std::find(entities.names.begin(), entities.names.end(), configuration_.entity());
+    if (ego == entities.names.end()) {
       throw SimulationRuntimeError("Failed to calculate ego pose with north up.");
     }
-    simulation_interface::toMsg(ego->pose(), ego_pose_north_up);
+    ego_pose_north_up = entities.poses[std::distance(entities.names.begin(), ego)];
     /**
      * @note
      * There is no problem with the yaw axis being north-up, but unless the pitch and roll axes are
@@ -101,47 +84,44 @@ auto OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>::getOccupancyGrid(
     ego_pose_north_up.orientation = geometry_msgs::msg::Quaternion();
   }
 
-  // construct a `set` of detected object names to look up entities later
-  auto detected_entities = std::set<std::string>();
-  {
-    if (configuration_.filter_by_range()) {
-      auto v = getDetectedObjects(status, lidar_detected_entities);
-      detected_entities.insert(v.begin(), v.end());
-    } else {
-      detected_entities.insert(lidar_detected_entities.begin(), lidar_detected_entities.end());
-    }
+  // flag the entities actually detected, indexed in the same way as `entities`
+  if (configuration_.filter_by_range()) {
+    getDetectedObjects(entities, lidar_detected_entities, detected_entities_);
+  } else {
+    detected_entities_.assign(lidar_detected_entities.begin(), lidar_detected_entities.end());
   }
 
   // construct an occupancy grid
+  if (primitives_.size() < entities.size()) {
+    primitives_.resize(entities.size());
+  }
   builder_.reset(ego_pose_north_up);
-  for (const auto & s : status) {
-    if (configuration_.entity() != s.name()) {
+  for (std::size_t i = 0; i < entities.size(); ++i) {
+    if (configuration_.entity() != entities.names[i]) {
       // skip if entity is not actually detected
-      if (detected_entities.count(s.name()) == 0) {
+      if (!detected_entities_[i]) {
         continue;
       }
 
-      auto pose = geometry_msgs::msg::Pose();
-      {
-        simulation_interface::toMsg(s.pose(), pose);
-        auto point = geometry_msgs::msg::Point();
-        simulation_interface::toMsg(s.bounding_box().center(), point);
-        auto rotation = quaternion_operation::getRotationMatrix(pose.orientation);
-        auto center = (rotation * Eigen::Vector3d(point.x, point.y, point.z)).eval();
-
-        pose.position.x += center.x();
-        pose.position.y += center.y();
-        pose.position.z += center.z();
+      const auto & dimensions = entities.bounding_box_dimensions[i];
+      const auto & pose = entities.bounding_box_poses[i];
+      auto & primitive = primitives_[i];
+      if (
+        primitive.convex_hull.empty() or primitive.name != entities.names[i] or
+        primitive.dimensions != dimensions or primitive.pose != pose) {
+        primitive.name = entities.names[i];
+        primitive.dimensions = dimensions;
+        primitive.pose = pose;
+        primitive.convex_hull =
+          primitives::Box(dimensions.x, dimensions.y, dimensions.z, pose).get2DConvexHull();
       }
-
-      const auto & v = s.bounding_box().dimensions();
-      builder_.add(primitives::Box(v.x(), v.y(), v.z(), pose));
+      builder_.add(primitive.convex_hull, i);
     }
   }
   builder_.build();
 
   // construct message
-  auto res = nav_msgs::msg::OccupancyGrid();
+  auto & res = occupancy_grid_;
   res.header.stamp = stamp;
   res.header.frame_id = "map";
   res.data = builder_.get();
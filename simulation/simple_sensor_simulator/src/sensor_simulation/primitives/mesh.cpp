@@ -0,0 +1,30 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <simple_sensor_simulator/sensor_simulation/primitives/mesh.hpp>
+#include <utility>
+#include <vector>
+
+namespace simple_sensor_simulator
+{
+namespace primitives
+{
+Mesh::Mesh(std::vector<Vertex> vertices, std::vector<Triangle> triangles)
+: Primitive("Mesh", geometry_msgs::msg::Pose())
+{
+  vertices_ = std::move(vertices);
+  triangles_ = std::move(triangles);
+}
+}  // namespace primitives
+}  // namespace simple_sensor_simulator
@@ -114,7 +114,7 @@ std::vector<geometry_msgs::msg::Point> Primitive::get2DConvexHull() const
   return math::geometry::get2DConvexHull(toPoints(transform()));
 }
 
-unsigned int Primitive::addToScene(RTCDevice device, RTCScene scene)
+unsigned int Primitive::addToScene(RTCDevice device, RTCScene scene) const
 {
   RTCGeometry mesh = rtcNewGeometry(device, RTC_GEOMETRY_TYPE_TRIANGLE);
   const auto transformed_vertices = transform();
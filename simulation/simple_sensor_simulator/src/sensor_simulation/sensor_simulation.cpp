@@ -12,39 +12,62 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <cstddef>
 #include <memory>
 #include <simple_sensor_simulator/sensor_simulation/sensor_simulation.hpp>
-#include <string>
 #include <vector>
 
 namespace simple_sensor_simulator
 {
 auto SensorSimulation::updateSensorFrame(
   double current_simulation_time, const rclcpp::Time & current_ros_time,
-  const std::vector<traffic_simulator_msgs::EntityStatus> & entities,
+  const EntityFrame & entities,
   const simulation_api_schema::UpdateTrafficLightsRequest & update_traffic_lights_request) -> void
 {
-  std::vector<std::string> lidar_detected_objects = {};
+  /*
+     Traffic light detectors depend on nothing but the traffic lights, so they
+     are updated concurrently with all the other sensors. Lidars depend on
+     nothing but the entities, so they are updated concurrently with each
+     other. Detection and occupancy grid sensors both read the entities
+     detected by the lidars, so they are updated concurrently with each other
+     after every lidar has finished.
 
-  for (auto & sensor : lidar_sensors_) {
-    sensor->update(current_simulation_time, entities, current_ros_time);
-    for (const auto & object : sensor->getDetectedObjects()) {
-      if (std::count(lidar_detected_objects.begin(), lidar_detected_objects.end(), object) == 0) {
-        lidar_detected_objects.push_back(object);
-      }
-    }
-  }
+     Each sensor owns its state and publisher, and the entities are only read,
+     so sensors updated concurrently share nothing mutable.
 
-  for (auto & sensor : detection_sensors_) {
-    sensor->update(current_simulation_time, entities, current_ros_time, lidar_detected_objects);
-  }
+     NOTE: Every update runs on the pool of the simulation, which the
+     raycasters and occupancy grid builders of the sensors run their own tasks
+     on too, so no thread is created per sensor or per frame.
+  */
+  worker_pool_.run(2, [&](std::size_t branch) {
+    if (branch == 0) {
+      worker_pool_.run(traffic_lights_detectors_.size(), [&](std::size_t i) {
+        traffic_lights_detectors_[i]->updateFrame(current_ros_time, update_traffic_lights_request);
+      });
+    } else {
+      worker_pool_.run(lidar_sensors_.size(), [&](std::size_t i) {
+        lidar_sensors_[i]->update(current_simulation_time, entities, current_ros_time);
+      });
 
-  for (auto & sensor : occupancy_grid_sensors_) {
-    sensor->update(current_simulation_time, entities, current_ros_time, lidar_detected_objects);
-  }
+      lidar_detected_entities_.assign(entities.size(), false);
 
-  for (auto & sensor : traffic_lights_detectors_) {
-    sensor->updateFrame(current_ros_time, update_traffic_lights_request);
-  }
+      for (auto & sensor : lidar_sensors_) {
+        for (const auto index : sensor->getDetectedObjects()) {
+          lidar_detected_entities_[index] = true;
+        }
+      }
+
+      worker_pool_.run(
+        detection_sensors_.size() + occupancy_grid_sensors_.size(), [&](std::size_t i) {
+          if (i < detection_sensors_.size()) {
+            detection_sensors_[i]->update(
+              current_simulation_time, entities, current_ros_time, lidar_detected_entities_);
+          } else {
+            occupancy_grid_sensors_[i - detection_sensors_.size()]->update(
+              current_simulation_time, entities, current_ros_time, lidar_detected_entities_);
+          }
+        });
+    }
+  });
 }
 }  // namespace simple_sensor_simulator
@@ -0,0 +1,109 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <algorithm>
+#include <cstddef>
+#include <mutex>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
+
+namespace simple_sensor_simulator
+{
+WorkerPool::WorkerPool(std::size_t size)
+{
+  for (std::size_t i = 1; i < size; ++i) {
+    threads_.emplace_back([this]() {
+      for (auto lock = std::unique_lock(mutex_);;) {
+        condition_.wait(lock, [this]() { return is_stop_requested_ or not jobs_.empty(); });
+        if (is_stop_requested_) {
+          return;
+        } else {
+          auto & job = *jobs_.front();
+          ++job.helper_count;
+          lock.unlock();
+          work(job);
+          lock.lock();
+          // Every task of the job has been claimed, so stop offering it
+          if (auto iter = std::find(jobs_.begin(), jobs_.end(), &job); iter != jobs_.end()) {
+            jobs_.erase(iter);
+          }
+          if (--job.helper_count == 0) {
+            condition_.notify_all();
+          }
+        }
+      }
+    });
+  }
+}
+
+WorkerPool::~WorkerPool()
+{
+  {
+    auto lock = std::lock_guard(mutex_);
+    is_stop_requested_ = true;
+  }
+
+  condition_.notify_all();
+
+  for (auto && thread : threads_) {
+    thread.join();
+  }
+}
+
+auto WorkerPool::run(std::size_t count, void (*call)(const void *, std::size_t), const void * f)
+  -> void
+{
+  if (count == 0) {
+    return;
+  }
+
+  Job job{count, call, f};
+
+  if (1 < count and not threads_.empty()) {
+    {
+      auto lock = std::lock_guard(mutex_);
+      jobs_.push_back(&job);
+    }
+    condition_.notify_all();
+  }
+
+  work(job);
+
+  auto lock = std::unique_lock(mutex_);
+
+  if (auto iter = std::find(jobs_.begin(), jobs_.end(), &job); iter != jobs_.end()) {
+    jobs_.erase(iter);
+  }
+
+  // NOTE: No thread starts helping after the job is removed from `jobs_`
+  condition_.wait(lock, [&]() { return job.helper_count == 0; });
+
+  if (job.exception) {
+    std::rethrow_exception(job.exception);
+  }
+}
+
+auto WorkerPool::work(Job & job) -> void
+{
+  for (auto i = job.next++; i < job.count; i = job.next++) {
+    try {
+      job.call(job.f, i);
+    } catch (...) {
+      auto lock = std::lock_guard(mutex_);
+      if (not job.exception) {
+        job.exception = std::current_exception();
+      }
+    }
+  }
+}
+}  // namespace simple_sensor_simulator
@@ -15,7 +15,10 @@
 #include <quaternion_operation/quaternion_operation.h>
 
 #include <algorithm>
+#include <fstream>
+#include <functional>
 #include <geometry_msgs/msg/pose_stamped.hpp>
+#include <iterator>
 #include <limits>
 #include <memory>
 #include <rclcpp/rclcpp.hpp>
@@ -29,6 +32,19 @@
 
 namespace simple_sensor_simulator
 {
+namespace
+{
+auto hashFileContent(const std::string & path) -> std::size_t
+{
+  if (auto file = std::ifstream(path); file) {
+    return std::hash<std::string>()(
+      std::string(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>()));
+  } else {
+    THROW_SIMULATION_ERROR("Failed to open lanelet2 map file ", path);
+  }
+}
+}  // namespace
+
 ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
 : Node("simple_sensor_simulator", options),
   server_(
@@ -49,6 +65,7 @@ ScenarioSimulator::ScenarioSimulator(const rclcpp::NodeOptions & options)
     },
     [this](auto &&... xs) { return updateStepTime(std::forward<decltype(xs)>(xs)...); })
 {
+  declare_parameter("lidar_static_map", false);
 }
 
 geographic_msgs::msg::GeoPoint ScenarioSimulator::getOrigin()
@@ -87,15 +104,22 @@ auto ScenarioSimulator::initialize(const simulation_api_schema::InitializeReques
   builtin_interfaces::msg::Time t;
   simulation_interface::toMsg(req.initialize_ros_time(), t);
   current_ros_time_ = t;
-  hdmap_utils_ = std::make_shared<hdmap_utils::HdMapUtils>(req.lanelet2_map_path(), getOrigin());
+  const auto origin = getOrigin();
+  if (auto key = std::make_tuple(
+        req.lanelet2_map_path(), hashFileContent(req.lanelet2_map_path()), origin.latitude,
+        origin.longitude);
+      not hdmap_utils_ or key != hdmap_utils_key_) {
+    hdmap_utils_ = std::make_shared<hdmap_utils::HdMapUtils>(req.lanelet2_map_path(), origin);
+    hdmap_utils_key_ = std::move(key);
+    lidar_static_map_.reset();
+  }
   auto res = simulation_api_schema::InitializeResponse();
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to initialize simulation");
-  ego_vehicles_.clear();
-  vehicles_.clear();
-  pedestrians_.clear();
-  misc_objects_.clear();
-  entity_status_.clear();
+  entities_.clear();
+  ego_entity_simulation_.reset();
+  traffic_signals_states_.Clear();
+  sensor_sim_.detachAllSensors();
   return res;
 }
 
@@ -113,21 +137,8 @@ auto ScenarioSimulator::updateFrame(const simulation_api_schema::UpdateFrameRequ
   builtin_interfaces::msg::Time t;
   simulation_interface::toMsg(req.current_ros_time(), t);
   current_ros_time_ = t;
-  std::vector<traffic_simulator_msgs::EntityStatus> entity_status;
-  std::transform(
-    entity_status_.begin(), entity_status_.end(), std::back_inserter(entity_status),
-    [this](const auto & map_element) {
-      traffic_simulator_msgs::EntityStatus status;
-      *status.mutable_pose() = map_element.second.pose();
-      *status.mutable_action_status() = map_element.second.action_status();
-      *status.mutable_name() = map_element.second.name();
-      *status.mutable_type() = map_element.second.type();
-      *status.mutable_subtype() = map_element.second.subtype();
-      *status.mutable_bounding_box() = getBoundingBox(status.name());
-      return status;
-    });
   sensor_sim_.updateSensorFrame(
-    current_simulation_time_, current_ros_time_, entity_status, traffic_signals_states_);
+    current_simulation_time_, current_ros_time_, entities_.frame(), traffic_signals_states_);
   res.mutable_result()->set_success(true);
   res.mutable_result()->set_description("succeed to update frame");
   return res;
@@ -156,7 +167,7 @@ auto ScenarioSimulator::updateEntityStatus(
 
   for (const auto & status : req.status()) {
     try {
-      if (isEgo(status.name())) {
+      if (entities_.isEgo(status.name())) {
         assert(ego_entity_simulation_ && "Ego is spawned but ego_entity_simulation_ is nullptr!");
         if (req.overwrite_ego_status()) {
           traffic_simulator_msgs::msg::EntityStatus ego_status_msg;
@@ -170,10 +181,10 @@ auto ScenarioSimulator::updateEntityStatus(
         }
         simulation_api_schema::EntityStatus ego_status;
         simulation_interface::toProto(ego_entity_simulation_->getStatus(), ego_status);
-        entity_status_.at(status.name()) = ego_status;
+        entities_.update(ego_status);
         copyStatusToResponse(ego_status);
       } else {
-        entity_status_.at(status.name()) = status;
+        entities_.update(status);
         copyStatusToResponse(status);
       }
     } catch (const std::out_of_range & e) {
@@ -191,27 +202,27 @@ auto ScenarioSimulator::insertEntitySpawnedStatus(
   const SpawnRequestType & spawn_request, const traffic_simulator_msgs::EntityType::Enum & type,
   const traffic_simulator_msgs::EntitySubtype::Enum & subtype) -> void
 {
-  simulation_api_schema::EntityStatus init_status;
+  traffic_simulator_msgs::EntityStatus init_status;
   init_status.mutable_type()->set_type(type);
   init_status.mutable_subtype()->set_value(subtype);
   init_status.set_time(current_scenario_time_);
   init_status.set_name(spawn_request.parameters().name());
+  init_status.mutable_bounding_box()->CopyFrom(spawn_request.parameters().bounding_box());
   init_status.mutable_action_status()->set_current_action("initializing");
   init_status.mutable_pose()->CopyFrom(spawn_request.pose());
-  entity_status_.insert({spawn_request.parameters().name(), init_status});
+  entities_.insert(init_status, type == traffic_simulator_msgs::EntityType::EGO);
 }
 
 auto ScenarioSimulator::spawnVehicleEntity(
   const simulation_api_schema::SpawnVehicleEntityRequest & req)
   -> simulation_api_schema::SpawnVehicleEntityResponse
 {
-  if (ego_vehicles_.size() != 0 && req.is_ego()) {
+  if (ego_entity_simulation_ && req.is_ego()) {
     throw SimulationRuntimeError("multi ego does not support");
   }
   auto entity_type = traffic_simulator_msgs::EntityType::VEHICLE;
   if (req.is_ego()) {
     entity_type = traffic_simulator_msgs::EntityType::EGO;
-    ego_vehicles_.emplace_back(req.parameters());
     traffic_simulator_msgs::msg::VehicleParameters parameters;
     simulation_interface::toMsg(req.parameters(), parameters);
     auto get_consider_acceleration_by_road_slope = [&]() {
@@ -227,7 +238,7 @@ auto ScenarioSimulator::spawnVehicleEntity(
       return get_parameter("consider_pose_by_road_slope").as_bool();
     };
     ego_entity_simulation_ = std::make_shared<vehicle_simulation::EgoEntitySimulation>(
-      parameters, step_time_, hdmap_utils_,
+      parameters, step_time_, hdmap_utils_, *get_node_parameters_interface(),
       get_parameter_or("use_sim_time", rclcpp::Parameter("use_sim_time", false)),
       get_consider_acceleration_by_road_slope(), get_consider_pose_by_road_slope());
     traffic_simulator_msgs::msg::EntityStatus initial_status;
@@ -236,8 +247,6 @@ auto ScenarioSimulator::spawnVehicleEntity(
     initial_status.bounding_box = parameters.bounding_box;
     ego_entity_simulation_->fillLaneletDataAndSnapZToLanelet(initial_status);
     ego_entity_simulation_->setInitialStatus(initial_status);
-  } else {
-    vehicles_.emplace_back(req.parameters());
   }
   insertEntitySpawnedStatus(req, entity_type, traffic_simulator_msgs::EntitySubtype::UNKNOWN);
   auto res = simulation_api_schema::SpawnVehicleEntityResponse();
@@ -250,7 +259,6 @@ auto ScenarioSimulator::spawnPedestrianEntity(
   const simulation_api_schema::SpawnPedestrianEntityRequest & req)
   -> simulation_api_schema::SpawnPedestrianEntityResponse
 {
-  pedestrians_.emplace_back(req.parameters());
   insertEntitySpawnedStatus(
     req, traffic_simulator_msgs::EntityType::PEDESTRIAN,
     traffic_simulator_msgs::EntitySubtype::UNKNOWN);
@@ -264,7 +272,6 @@ auto ScenarioSimulator::spawnMiscObjectEntity(
   const simulation_api_schema::SpawnMiscObjectEntityRequest & req)
   -> simulation_api_schema::SpawnMiscObjectEntityResponse
 {
-  misc_objects_.emplace_back(req.parameters());
   insertEntitySpawnedStatus(
     req, traffic_simulator_msgs::EntityType::MISC_OBJECT,
     traffic_simulator_msgs::EntitySubtype::UNKNOWN);
@@ -277,28 +284,11 @@ auto ScenarioSimulator::spawnMiscObjectEntity(
 auto ScenarioSimulator::despawnEntity(const simulation_api_schema::DespawnEntityRequest & req)
   -> simulation_api_schema::DespawnEntityResponse
 {
-  auto remove_despawn_requested_entity_from = [&](auto & v) {
-    const auto size = std::size(v);
-    v.erase(
-      std::remove_if(
-        std::begin(v), std::end(v),
-        [&](const auto & entity) { return entity.name() == req.name(); }),
-      std::end(v));
-    return size != std::size(v);  // true if something removed.
-  };
-  const auto ego_entity_was_removed = remove_despawn_requested_entity_from(ego_vehicles_);
-  if (ego_entity_was_removed) {
+  if (entities_.isEgo(req.name())) {
     ego_entity_simulation_.reset();
   }
-  const auto any_entity_was_removed = ego_entity_was_removed or
-                                      remove_despawn_requested_entity_from(vehicles_) or
-                                      remove_despawn_requested_entity_from(pedestrians_) or
-                                      remove_despawn_requested_entity_from(misc_objects_);
-  if (any_entity_was_removed) {
-    entity_status_.erase(req.name());
-  }
   auto res = simulation_api_schema::DespawnEntityResponse();
-  res.mutable_result()->set_success(any_entity_was_removed);
+  res.mutable_result()->set_success(entities_.erase(req.name()));
   return res;
 }
 
@@ -312,11 +302,23 @@ auto ScenarioSimulator::attachDetectionSensor(
   return res;
 }
 
+auto ScenarioSimulator::getLidarStaticMap() -> std::shared_ptr<const primitives::Primitive>
+{
+  if (not get_parameter("lidar_static_map").as_bool()) {
+    return nullptr;
+  } else if (not lidar_static_map_) {
+    lidar_static_map_ =
+      std::make_shared<const primitives::Mesh>(makeStaticMapMesh(hdmap_utils_->getLaneletMap()));
+  }
+  return lidar_static_map_;
+}
+
 auto ScenarioSimulator::attachLidarSensor(
   const simulation_api_schema::AttachLidarSensorRequest & req)
   -> simulation_api_schema::AttachLidarSensorResponse
 {
-  sensor_sim_.attachLidarSensor(current_simulation_time_, req.configuration(), *this);
+  sensor_sim_.attachLidarSensor(
+    current_simulation_time_, req.configuration(), *this, getLidarStaticMap());
   auto res = simulation_api_schema::AttachLidarSensorResponse();
   res.mutable_result()->set_success(true);
   return res;
@@ -352,44 +354,6 @@ auto ScenarioSimulator::attachPseudoTrafficLightDetector(
   response.mutable_result()->set_success(true);
   return response;
 }
-
-traffic_simulator_msgs::BoundingBox ScenarioSimulator::getBoundingBox(const std::string & name)
-{
-  for (const auto & ego : ego_vehicles_) {
-    if (ego.name() == name) {
-      return ego.bounding_box();
-    }
-  }
-  for (const auto & vehicle : vehicles_) {
-    if (vehicle.name() == name) {
-      return vehicle.bounding_box();
-    }
-  }
-  for (const auto & pedestrian : pedestrians_) {
-    if (pedestrian.name() == name) {
-      return pedestrian.bounding_box();
-    }
-  }
-  for (const auto & misc_object : misc_objects_) {
-    if (misc_object.name() == name) {
-      return misc_object.bounding_box();
-    }
-  }
-
-  THROW_SEMANTIC_ERROR("Entity : ", std::quoted(name), " does not exist");
-}
-
-bool ScenarioSimulator::isEgo(const std::string & name)
-{
-  return std::find_if(ego_vehicles_.begin(), ego_vehicles_.end(), [&](auto && entity) {
-           return entity.name() == name;
-         }) != std::end(ego_vehicles_);
-}
-
-bool ScenarioSimulator::isEntityExists(const std::string & name)
-{
-  return entity_status_.find(name) != entity_status_.end();
-}
 }  // namespace simple_sensor_simulator
 
 RCLCPP_COMPONENTS_REGISTER_NODE(simple_sensor_simulator::ScenarioSimulator)
@@ -19,26 +19,37 @@
 
 namespace vehicle_simulation
 {
-/// @todo find some shared space for this function
+/**
+ * @note Reads the parameter from the owning node instead of creating a node for each parameter. If
+ * the parameter is not declared on the node, the override given to the process (e.g. by
+ * "vehicle_info.param.yaml" and "simulator_model.param.yaml") is used, and the default value
+ * otherwise. Each call may use a different default value, so the parameter is not declared here.
+ */
 template <typename T>
-static auto getParameter(const std::string & name, T value = {})
+static auto getParameter(
+  const rclcpp::node_interfaces::NodeParametersInterface & node_parameters,
+  const std::string & name, T value = {})
 {
-  rclcpp::Node node{"get_parameter", "simulation"};
-
-  node.declare_parameter<T>(name, value);
-  node.get_parameter<T>(name, value);
-
-  return value;
+  if (node_parameters.has_parameter(name)) {
+    return node_parameters.get_parameter(name).get_value<T>();
+  } else if (const auto & overrides = node_parameters.get_parameter_overrides();
+             overrides.find(name) != std::end(overrides)) {
+    return overrides.at(name).get<T>();
+  } else {
+    return value;
+  }
 }
 
 EgoEntitySimulation::EgoEntitySimulation(
   const traffic_simulator_msgs::msg::VehicleParameters & parameters, double step_time,
   const std::shared_ptr<hdmap_utils::HdMapUtils> & hdmap_utils,
+  const rclcpp::node_interfaces::NodeParametersInterface & node_parameters,
   const rclcpp::Parameter & use_sim_time, const bool consider_acceleration_by_road_slope,
   const bool consider_pose_by_road_slope)
 : autoware(std::make_unique<concealer::AutowareUniverse>()),
-  vehicle_model_type_(getVehicleModelType()),
-  vehicle_model_ptr_(makeSimulationModel(vehicle_model_type_, step_time, parameters)),
+  vehicle_model_type_(getVehicleModelType(node_parameters)),
+  vehicle_model_ptr_(
+    makeSimulationModel(vehicle_model_type_, step_time, parameters, node_parameters)),
   hdmap_utils_ptr_(hdmap_utils),
   vehicle_parameters(parameters),
   consider_acceleration_by_road_slope_(consider_acceleration_by_road_slope),
@@ -68,10 +79,11 @@ auto toString(const VehicleModelType datum) -> std::string
   THROW_SIMULATION_ERROR("Unsupported vehicle model type, failed to convert to string");
 }
 
-auto EgoEntitySimulation::getVehicleModelType() -> VehicleModelType
+auto EgoEntitySimulation::getVehicleModelType(
+  const rclcpp::node_interfaces::NodeParametersInterface & node_parameters) -> VehicleModelType
 {
   const auto vehicle_model_type =
-    getParameter<std::string>("vehicle_model_type", "IDEAL_STEER_VEL");
+    getParameter<std::string>(node_parameters, "vehicle_model_type", "IDEAL_STEER_VEL");
 
   static const std::unordered_map<std::string, VehicleModelType> table{
     {"DELAY_STEER_ACC", VehicleModelType::DELAY_STEER_ACC},
@@ -94,25 +106,26 @@ auto EgoEntitySimulation::getVehicleModelType() -> VehicleModelType
 
 auto EgoEntitySimulation::makeSimulationModel(
   const VehicleModelType vehicle_model_type, const double step_time,
-  const traffic_simulator_msgs::msg::VehicleParameters & parameters)
+  const traffic_simulator_msgs::msg::VehicleParameters & parameters,
+  const rclcpp::node_interfaces::NodeParametersInterface & node_parameters)
   -> const std::shared_ptr<SimModelInterface>
 {
   // clang-format off
-  const auto acc_time_constant          = getParameter<double>("acc_time_constant",           0.1);
-  const auto acc_time_delay             = getParameter<double>("acc_time_delay",              0.1);
-  const auto acceleration_map_path      = getParameter<std::string>("acceleration_map_path",  "");
-  const auto debug_acc_scaling_factor   = getParameter<double>("debug_acc_scaling_factor",    1.0);
-  const auto debug_steer_scaling_factor = getParameter<double>("debug_steer_scaling_factor",  1.0);
-  const auto steer_lim                  = getParameter<double>("steer_lim",                   parameters.axles.front_axle.max_steering);  // 1.0
-  const auto steer_dead_band            = getParameter<double>("steer_dead_band",             0.0);
-  const auto steer_rate_lim             = getParameter<double>("steer_rate_lim",              5.0);
-  const auto steer_time_constant        = getParameter<double>("steer_time_constant",         0.27);
-  const auto steer_time_delay           = getParameter<double>("steer_time_delay",            0.24);
-  const auto vel_lim                    = getParameter<double>("vel_lim",                     parameters.performance.max_speed);  // 50.0
-  const auto vel_rate_lim               = getParameter<double>("vel_rate_lim",                parameters.performance.max_acceleration);  // 7.0
-  const auto vel_time_constant          = getParameter<double>("vel_time_constant",           0.1);  /// @note 0.5 is default value on simple_planning_simulator
-  const auto vel_time_delay             = getParameter<double>("vel_time_delay",              0.1);  /// @note 0.25 is default value on simple_planning_simulator
-  const auto wheel_base                 = getParameter<double>("wheel_base",                  parameters.axles.front_axle.position_x - parameters.axles.rear_axle.position_x);
+  const auto acc_time_constant          = getParameter<double>(node_parameters, "acc_time_constant",           0.1);
+  const auto acc_time_delay             = getParameter<double>(node_parameters, "acc_time_delay",              0.1);
+  const auto acceleration_map_path      = getParameter<std::string>(node_parameters, "acceleration_map_path",  "");
+  const auto debug_acc_scaling_factor   = getParameter<double>(node_parameters, "debug_acc_scaling_factor",    1.0);
+  const auto debug_steer_scaling_factor = getParameter<double>(node_parameters, "debug_steer_scaling_factor",  1.0);
+  const auto steer_lim                  = getParameter<double>(node_parameters, "steer_lim",                   parameters.axles.front_axle.max_steering);  // 1.0
+  const auto steer_dead_band            = getParameter<double>(node_parameters, "steer_dead_band",             0.0);
+  const auto steer_rate_lim             = getParameter<double>(node_parameters, "steer_rate_lim",              5.0);
+  const auto steer_time_constant        = getParameter<double>(node_parameters, "steer_time_constant",         0.27);
+  const auto steer_time_delay           = getParameter<double>(node_parameters, "steer_time_delay",            0.24);
+  const auto vel_lim                    = getParameter<double>(node_parameters, "vel_lim",                     parameters.performance.max_speed);  // 50.0
+  const auto vel_rate_lim               = getParameter<double>(node_parameters, "vel_rate_lim",                parameters.performance.max_acceleration);  // 7.0
+  const auto vel_time_constant          = getParameter<double>(node_parameters, "vel_time_constant",           0.1);  /// @note 0.5 is default value on simple_planning_simulator
+  const auto vel_time_delay             = getParameter<double>(node_parameters, "vel_time_delay",              0.1);  /// @note 0.25 is default value on simple_planning_simulator
+  const auto wheel_base                 = getParameter<double>(node_parameters, "wheel_base",                  parameters.axles.front_axle.position_x - parameters.axles.rear_axle.position_x);
   // clang-format on
 
   switch (vehicle_model_type) {
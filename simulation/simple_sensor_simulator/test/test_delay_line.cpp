@@ -0,0 +1,106 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <simple_sensor_simulator/sensor_simulation/delay_line.hpp>
+#include <vector>
+
+using simple_sensor_simulator::DelayLine;
+
+TEST(DelayLine, zeroDelay)
+{
+  auto delay_line = DelayLine<std::vector<int>>(0, 0.1);
+
+  const auto slot = &delay_line.next();
+
+  for (auto i = 0; i < 10; ++i) {
+    auto & message = delay_line.next();
+    EXPECT_EQ(&message, slot);  // NOTE: the same slot is reused every time
+    message.assign(3, i);
+    delay_line.push(i * 0.1);
+    ASSERT_FALSE(delay_line.empty());
+    EXPECT_EQ(delay_line.front(), std::vector<int>(3, i));
+    EXPECT_DOUBLE_EQ(delay_line.frontTime(), i * 0.1);
+    delay_line.pop();
+    EXPECT_TRUE(delay_line.empty());
+  }
+}
+
+TEST(DelayLine, wraparound)
+{
+  auto delay_line = DelayLine<int>(0.3, 0.1);
+
+  for (auto i = 0; i < 20; ++i) {
+    delay_line.next() = i;
+    delay_line.push(i * 0.1);
+    if (3 <= i) {
+      EXPECT_EQ(delay_line.front(), i - 3);
+      EXPECT_DOUBLE_EQ(delay_line.frontTime(), (i - 3) * 0.1);
+      delay_line.pop();
+    }
+  }
+
+  for (auto i = 17; i < 20; ++i) {
+    ASSERT_FALSE(delay_line.empty());
+    EXPECT_EQ(delay_line.front(), i);
+    delay_line.pop();
+  }
+
+  EXPECT_TRUE(delay_line.empty());
+}
+
+TEST(DelayLine, growWithNonZeroHead)
+{
+  auto delay_line = DelayLine<int>(0.1, 0.1);  // NOTE: 2 slots
+
+  delay_line.next() = 0;
+  delay_line.push(0.0);
+  delay_line.next() = 1;
+  delay_line.push(0.1);
+  EXPECT_EQ(delay_line.front(), 0);
+  delay_line.pop();  // NOTE: the head is now the second slot
+
+  for (auto i = 2; i < 6; ++i) {  // NOTE: the ring buffer is full at i = 2 and grows at i = 3
+    delay_line.next() = i;
+    delay_line.push(i * 0.1);
+  }
+
+  for (auto i = 1; i < 6; ++i) {
+    ASSERT_FALSE(delay_line.empty());
+    EXPECT_EQ(delay_line.front(), i);
+    EXPECT_DOUBLE_EQ(delay_line.frontTime(), i * 0.1);
+    delay_line.pop();
+  }
+
+  EXPECT_TRUE(delay_line.empty());
+}
+
+TEST(DelayLine, nextWithoutPush)
+{
+  auto delay_line = DelayLine<int>(0.1, 0.1);
+
+  delay_line.next() = 42;  // NOTE: e.g. an exception is thrown before push
+  EXPECT_TRUE(delay_line.empty());
+
+  delay_line.next() = 0;
+  delay_line.push(0.0);
+  EXPECT_EQ(delay_line.front(), 0);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
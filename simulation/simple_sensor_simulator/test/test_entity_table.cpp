@@ -0,0 +1,155 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+#include <traffic_simulator_msgs.pb.h>
+
+#include <cstddef>
+#include <simple_sensor_simulator/entity_table.hpp>
+#include <stdexcept>
+#include <string>
+
+namespace
+{
+auto makeEntityStatus(const std::string & name, double x) -> traffic_simulator_msgs::EntityStatus
+{
+  traffic_simulator_msgs::EntityStatus status;
+  status.set_name(name);
+  status.mutable_type()->set_type(traffic_simulator_msgs::EntityType::VEHICLE);
+  status.mutable_pose()->mutable_position()->set_x(x);
+  status.mutable_pose()->mutable_orientation()->set_w(1);
+  status.mutable_bounding_box()->mutable_dimensions()->set_x(x + 1);
+  return status;
+}
+
+auto makeUpdate(const std::string & name, double x) -> simulation_api_schema::EntityStatus
+{
+  simulation_api_schema::EntityStatus status;
+  status.set_name(name);
+  status.mutable_type()->set_type(traffic_simulator_msgs::EntityType::VEHICLE);
+  status.mutable_pose()->mutable_position()->set_x(x);
+  status.mutable_pose()->mutable_orientation()->set_w(1);
+  return status;
+}
+
+/*
+   Checks that every entity in the frame is still described by the data it
+   was inserted (or last updated) with, wherever erasure has moved it.
+*/
+auto expectConsistent(const simple_sensor_simulator::EntityFrame & frame) -> void
+{
+  for (std::size_t i = 0; i < frame.size(); ++i) {
+    const auto x = frame.poses[i].position.x;
+    EXPECT_EQ(frame.names[i], "entity" + std::to_string(static_cast<int>(x)));
+    EXPECT_EQ(frame.bounding_box_poses[i].position.x, x);
+    EXPECT_EQ(frame.bounding_box_dimensions[i].x, x + 1);
+  }
+}
+}  // namespace
+
+TEST(EntityTable, insert)
+{
+  simple_sensor_simulator::EntityTable table;
+
+  EXPECT_TRUE(table.insert(makeEntityStatus("entity0", 0), true));
+  EXPECT_TRUE(table.insert(makeEntityStatus("entity1", 1), false));
+  EXPECT_FALSE(table.insert(makeEntityStatus("entity1", 2), false));
+
+  ASSERT_EQ(table.frame().size(), 2u);
+  EXPECT_TRUE(table.contains("entity0"));
+  EXPECT_TRUE(table.contains("entity1"));
+  EXPECT_FALSE(table.contains("entity2"));
+  EXPECT_TRUE(table.isEgo("entity0"));
+  EXPECT_FALSE(table.isEgo("entity1"));
+  EXPECT_EQ(table.frame().poses[1].position.x, 1);  // NOTE: unchanged by the failed insertion
+  expectConsistent(table.frame());
+}
+
+TEST(EntityTable, update)
+{
+  simple_sensor_simulator::EntityTable table;
+  table.insert(makeEntityStatus("entity0", 0), false);
+  table.insert(makeEntityStatus("entity1", 1), false);
+
+  table.update(makeUpdate("entity1", 5));
+  EXPECT_EQ(table.frame().poses[1].position.x, 5);
+  EXPECT_EQ(table.frame().bounding_box_poses[1].position.x, 5);
+  EXPECT_EQ(table.frame().poses[0].position.x, 0);
+
+  EXPECT_THROW(table.update(makeUpdate("entity2", 2)), std::out_of_range);
+  EXPECT_EQ(table.frame().size(), 2u);
+}
+
+TEST(EntityTable, eraseMiddle)
+{
+  simple_sensor_simulator::EntityTable table;
+  for (auto i = 0; i < 4; ++i) {
+    table.insert(makeEntityStatus("entity" + std::to_string(i), i), i == 3);
+  }
+
+  EXPECT_TRUE(table.erase("entity1"));
+  EXPECT_FALSE(table.erase("entity1"));
+
+  ASSERT_EQ(table.frame().size(), 3u);
+  EXPECT_FALSE(table.contains("entity1"));
+
+  /*
+     NOTE: The last entity fills the hole, and the other entities keep their
+     indices.
+  */
+  EXPECT_EQ(table.frame().names[0], "entity0");
+  EXPECT_EQ(table.frame().names[1], "entity3");
+  EXPECT_EQ(table.frame().names[2], "entity2");
+  EXPECT_TRUE(table.isEgo("entity3"));
+  EXPECT_FALSE(table.isEgo("entity2"));
+  expectConsistent(table.frame());
+
+  /*
+     The moved entity must be found at its new index.
+  */
+  table.update(makeUpdate("entity3", 3));
+  EXPECT_EQ(table.frame().poses[1].position.x, 3);
+  table.update(makeUpdate("entity2", 2));
+  EXPECT_EQ(table.frame().poses[2].position.x, 2);
+  expectConsistent(table.frame());
+}
+
+TEST(EntityTable, eraseLast)
+{
+  simple_sensor_simulator::EntityTable table;
+  for (auto i = 0; i < 3; ++i) {
+    table.insert(makeEntityStatus("entity" + std::to_string(i), i), false);
+  }
+
+  EXPECT_TRUE(table.erase("entity2"));
+
+  ASSERT_EQ(table.frame().size(), 2u);
+  EXPECT_EQ(table.frame().names[0], "entity0");
+  EXPECT_EQ(table.frame().names[1], "entity1");
+  expectConsistent(table.frame());
+
+  EXPECT_TRUE(table.insert(makeEntityStatus("entity2", 2), false));
+  EXPECT_EQ(table.frame().names[2], "entity2");
+  EXPECT_TRUE(table.erase("entity0"));
+  EXPECT_TRUE(table.erase("entity1"));
+  EXPECT_TRUE(table.erase("entity2"));
+  EXPECT_EQ(table.frame().size(), 0u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,226 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <stdexcept>
+#include <geometry_msgs/msg/point.hpp>
+#include <geometry_msgs/msg/pose.hpp>
+#include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_builder.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
+#include <vector>
+
+namespace
+{
+using ConvexHull = std::vector<geometry_msgs::msg::Point>;
+
+auto makePose(double x, double y, double yaw = 0) -> geometry_msgs::msg::Pose
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.orientation.z = std::sin(yaw / 2);
+  pose.orientation.w = std::cos(yaw / 2);
+  return pose;
+}
+
+auto makeConvexHull(double x, double y, double yaw = 0) -> ConvexHull
+{
+  return simple_sensor_simulator::primitives::Box(4, 2, 1.5, makePose(x, y, yaw))
+    .get2DConvexHull();
+}
+
+struct Frame
+{
+  geometry_msgs::msg::Pose origin;
+
+  std::vector<ConvexHull> convex_hulls;
+};
+
+/*
+   Primitives added, moved and removed while the origin stays still, and then
+   while it moves.
+*/
+auto makeFrames() -> std::vector<Frame>
+{
+  const auto a = makeConvexHull(5, 0);
+  const auto b = makeConvexHull(-8, 3, 0.5);
+  const auto c = makeConvexHull(0, 10, 1);
+  // NOTE: covers the origin
+  const auto d = makeConvexHull(1, 0.5);
+  // NOTE: partly outside of the grid
+  const auto e = makeConvexHull(20.5, 0);
+  return {
+    {makePose(0, 0), {a, b}},
+    {makePose(0, 0), {a, b, c}},
+    {makePose(0, 0), {makeConvexHull(6, 0), b, c}},
+    {makePose(0, 0), {makeConvexHull(6, 0), c}},
+    {makePose(0, 0), {makeConvexHull(6, 0), c}},
+    {makePose(1, 0.5), {a, c}},
+    {makePose(1, 0.5), {a, b, c}},
+    {makePose(1, 0.5), {}},
+    {makePose(1, 0.5), {a, a}},
+    {makePose(1, 0.5), {a}},
+    {makePose(1, 0.5), {a, d}},
+    {makePose(1, 0.5), {e, a}},
+    {makePose(1, 0.5, 0.3), {e, a}},
+    {makePose(1, 0.5, 0.3), {e, c, b}},
+  };
+}
+
+auto makeBuilder(simple_sensor_simulator::WorkerPool & worker_pool)
+  -> simple_sensor_simulator::OccupancyGridBuilder
+{
+  return simple_sensor_simulator::OccupancyGridBuilder(worker_pool, 0.5, 100, 80, 100, 50);
+}
+
+auto build(simple_sensor_simulator::OccupancyGridBuilder & builder, const Frame & frame)
+  -> const std::vector<int8_t> &
+{
+  builder.reset(frame.origin);
+  for (const auto & convex_hull : frame.convex_hulls) {
+    builder.add(convex_hull);
+  }
+  builder.build();
+  return builder.get();
+}
+}  // namespace
+
+TEST(OccupancyGridBuilder, incrementalBuildEqualsBuildFromScratch)
+{
+  simple_sensor_simulator::WorkerPool worker_pool(4);
+
+  auto incremental_builder = makeBuilder(worker_pool);
+
+  for (const auto & frame : makeFrames()) {
+    const auto incremental = build(incremental_builder, frame);
+    auto builder = makeBuilder(worker_pool);
+    const auto & from_scratch = build(builder, frame);
+    EXPECT_EQ(incremental, from_scratch);
+    EXPECT_NE(
+      frame.convex_hulls.empty(),
+      std::any_of(from_scratch.begin(), from_scratch.end(), [](auto x) { return x != 0; }));
+  }
+}
+
+/*
+   While the origin stays still (e.g. the ego is stopped), only the primitives
+   added or changed since the previous build are rasterized, however many the
+   others are.
+*/
+TEST(OccupancyGridBuilder, stoppedOriginRasterizesChangedPrimitivesOnly)
+{
+  simple_sensor_simulator::WorkerPool worker_pool(4);
+
+  auto builder = makeBuilder(worker_pool);
+
+  std::vector<ConvexHull> convex_hulls;
+  for (auto i = 0; i < 200; ++i) {
+    convex_hulls.push_back(makeConvexHull(i % 20 * 2 - 20, i / 20 * 4 - 20, i * 0.1));
+  }
+
+  auto build_all = [&](const geometry_msgs::msg::Pose & origin) {
+    builder.reset(origin);
+    for (std::size_t id = 0; id < convex_hulls.size(); ++id) {
+      builder.add(convex_hulls[id], id);
+    }
+    return builder.build();
+  };
+
+  EXPECT_EQ(build_all(makePose(0, 0)), 200u);
+  EXPECT_EQ(build_all(makePose(0, 0)), 0u);
+
+  for (auto frame = 1; frame <= 10; ++frame) {
+    convex_hulls[frame * 7] = makeConvexHull(frame, -frame);
+    EXPECT_EQ(build_all(makePose(0, 0)), 1u);
+
+    auto fresh_builder = makeBuilder(worker_pool);
+    EXPECT_EQ(build(fresh_builder, {makePose(0, 0), convex_hulls}), builder.get());
+  }
+
+  // Removing a primitive rasterizes nothing, and adding it back rasterizes it alone
+  builder.reset(makePose(0, 0));
+  for (std::size_t id = 0; id < convex_hulls.size(); ++id) {
+    if (id != 42) {
+      builder.add(convex_hulls[id], id);
+    }
+  }
+  EXPECT_EQ(builder.build(), 0u);
+  EXPECT_EQ(build_all(makePose(0, 0)), 1u);
+
+  // Every primitive is rasterized again once the origin moves
+  EXPECT_EQ(build_all(makePose(1, 0)), 200u);
+}
+
+TEST(OccupancyGridBuilder, primitiveAddedTwiceInFrame)
+{
+  simple_sensor_simulator::WorkerPool worker_pool(1);
+
+  auto builder = makeBuilder(worker_pool);
+  builder.reset(makePose(0, 0));
+  builder.add(makeConvexHull(5, 0), 3);
+  EXPECT_THROW(builder.add(makeConvexHull(-5, 0), 3), std::runtime_error);
+}
+
+TEST(OccupancyGridBuilder, resultDoesNotDependOnPoolSize)
+{
+  simple_sensor_simulator::WorkerPool single_thread_pool(1);
+  for (const std::size_t size : {2, 4, 7, 64}) {
+    simple_sensor_simulator::WorkerPool worker_pool(size);
+    auto single_worker_builder = makeBuilder(single_thread_pool);
+    auto builder = makeBuilder(worker_pool);
+    for (const auto & frame : makeFrames()) {
+      EXPECT_EQ(build(builder, frame), build(single_worker_builder, frame));
+    }
+  }
+}
+
+TEST(OccupancyGridBuilder, resultDoesNotDependOnConcurrentBuilders)
+{
+  const auto frames = makeFrames();
+
+  auto build_all = [&](simple_sensor_simulator::WorkerPool & worker_pool) {
+    auto builder = makeBuilder(worker_pool);
+    std::vector<std::vector<int8_t>> grids;
+    for (const auto & frame : frames) {
+      grids.push_back(build(builder, frame));
+    }
+    return grids;
+  };
+
+  // Builders running concurrently share a pool, as in SensorSimulation
+  simple_sensor_simulator::WorkerPool worker_pool(4);
+  std::vector<std::future<std::vector<std::vector<int8_t>>>> futures;
+  for (std::size_t i = 0; i < 8; ++i) {
+    futures.push_back(std::async(std::launch::async, build_all, std::ref(worker_pool)));
+  }
+  simple_sensor_simulator::WorkerPool single_thread_pool(1);
+  const auto expected = build_all(single_thread_pool);
+  for (auto & future : futures) {
+    EXPECT_EQ(future.get(), expected);
+  }
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,184 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+#include <traffic_simulator_msgs.pb.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <geometry_msgs/msg/pose.hpp>
+#include <geometry_msgs/msg/vector3.hpp>
+#include <nav_msgs/msg/occupancy_grid.hpp>
+#include <rclcpp/rclcpp.hpp>
+#include <simple_sensor_simulator/sensor_simulation/entity_frame.hpp>
+#include <simple_sensor_simulator/sensor_simulation/occupancy_grid/occupancy_grid_sensor.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
+#include <string>
+#include <vector>
+
+namespace
+{
+using Sensor = simple_sensor_simulator::OccupancyGridSensor<nav_msgs::msg::OccupancyGrid>;
+
+auto makePose(double x, double y) -> geometry_msgs::msg::Pose
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.orientation.w = 1;
+  return pose;
+}
+
+auto makeDimensions(double x, double y) -> geometry_msgs::msg::Vector3
+{
+  geometry_msgs::msg::Vector3 dimensions;
+  dimensions.x = x;
+  dimensions.y = y;
+  dimensions.z = 1.5;
+  return dimensions;
+}
+
+/*
+   Entities of a frame and whether the lidar detects each of them.
+*/
+struct Frame
+{
+  simple_sensor_simulator::EntityFrame entities;
+
+  std::vector<bool> lidar_detected_entities;
+
+  auto add(
+    const std::string & name, traffic_simulator_msgs::EntityType::Enum type,
+    const geometry_msgs::msg::Pose & pose, const geometry_msgs::msg::Vector3 & dimensions,
+    bool lidar_detected) -> Frame &
+  {
+    entities.names.push_back(name);
+    entities.types.push_back(type);
+    entities.subtypes.push_back(traffic_simulator_msgs::EntitySubtype::CAR);
+    entities.poses.push_back(pose);
+    entities.twists.emplace_back();
+    entities.bounding_box_centers.emplace_back();
+    entities.bounding_box_dimensions.push_back(dimensions);
+    entities.bounding_box_poses.push_back(pose);
+    lidar_detected_entities.push_back(lidar_detected);
+    return *this;
+  }
+};
+
+/*
+   The ego stays at the origin, so that the sensor updates its grid
+   incrementally, while "npc" drops out and comes back under the same name
+   with the same and with a different bounding box, which then changes while
+   it stays detected.
+*/
+auto makeFrames() -> std::vector<Frame>
+{
+  using traffic_simulator_msgs::EntityType;
+
+  auto make_frame = [](
+                      bool npc_exists, bool npc_detected, const geometry_msgs::msg::Pose & pose,
+                      const geometry_msgs::msg::Vector3 & dimensions) {
+    Frame frame;
+    frame.add("ego", EntityType::EGO, makePose(0, 0), makeDimensions(4, 2), true);
+    if (npc_exists) {
+      frame.add("npc", EntityType::VEHICLE, pose, dimensions, npc_detected);
+    }
+    frame.add("other", EntityType::VEHICLE, makePose(-8, 6), makeDimensions(4, 2), true);
+    return frame;
+  };
+
+  return {
+    make_frame(true, true, makePose(8, 0), makeDimensions(4, 2)),
+    make_frame(true, false, makePose(8, 0), makeDimensions(4, 2)),
+    make_frame(true, true, makePose(8, 0), makeDimensions(4, 2)),
+    make_frame(true, false, makePose(8, 0), makeDimensions(4, 2)),
+    make_frame(true, true, makePose(0, -8), makeDimensions(4, 2)),
+    make_frame(false, false, makePose(0, -8), makeDimensions(4, 2)),
+    make_frame(true, true, makePose(0, -8), makeDimensions(6, 3)),
+    make_frame(true, true, makePose(0, -8), makeDimensions(6, 3)),
+    make_frame(true, true, makePose(0, -8), makeDimensions(4, 2)),
+    make_frame(true, true, makePose(8, 0), makeDimensions(4, 2)),
+  };
+}
+
+auto makeSensor(simple_sensor_simulator::WorkerPool & worker_pool) -> Sensor
+{
+  simulation_api_schema::OccupancyGridSensorConfiguration configuration;
+  configuration.set_entity("ego");
+  configuration.set_resolution(0.5);
+  configuration.set_height(100);
+  configuration.set_width(80);
+  configuration.set_range(100);
+  configuration.set_filter_by_range(false);
+  return Sensor(0, configuration, nullptr, worker_pool);
+}
+
+}  // namespace
+
+namespace simple_sensor_simulator
+{
+/*
+   Builds grids without publishing them, which update would do.
+*/
+class OccupancyGridSensorTest
+{
+public:
+  static auto getOccupancyGrid(Sensor & sensor, const Frame & frame) -> std::vector<int8_t>
+  {
+    return sensor.getOccupancyGrid(frame.entities, rclcpp::Time(0), frame.lidar_detected_entities)
+      .data;
+  }
+};
+}  // namespace simple_sensor_simulator
+
+using simple_sensor_simulator::OccupancyGridSensorTest;
+
+TEST(OccupancyGridSensor, entityDroppingOutAndComingBack)
+{
+  const auto frames = makeFrames();
+
+  simple_sensor_simulator::WorkerPool worker_pool(2);
+
+  auto sensor = makeSensor(worker_pool);
+
+  std::vector<std::vector<int8_t>> grids;
+  for (const auto & frame : frames) {
+    auto fresh_sensor = makeSensor(worker_pool);
+    grids.push_back(OccupancyGridSensorTest::getOccupancyGrid(sensor, frame));
+    EXPECT_EQ(grids.back(), OccupancyGridSensorTest::getOccupancyGrid(fresh_sensor, frame));
+  }
+
+  auto count = [](const std::vector<int8_t> & grid, int8_t value) {
+    return std::count(grid.begin(), grid.end(), value);
+  };
+
+  // "npc" is marked only while detected, at the same cells when it comes back unchanged
+  EXPECT_GT(count(grids[0], 100), count(grids[1], 100));
+  EXPECT_EQ(grids[0], grids[2]);
+  EXPECT_EQ(grids[1], grids[3]);
+  EXPECT_NE(grids[2], grids[4]);
+  EXPECT_EQ(grids[3], grids[5]);
+  EXPECT_GT(count(grids[6], 100), count(grids[4], 100));
+  EXPECT_EQ(grids[6], grids[7]);
+  EXPECT_EQ(grids[4], grids[8]);
+  EXPECT_EQ(grids[0], grids[9]);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
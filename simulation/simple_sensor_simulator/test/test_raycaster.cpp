@@ -0,0 +1,140 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <simulation_api_schema.pb.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <geometry_msgs/msg/pose.hpp>
+#include <memory>
+#include <rclcpp/rclcpp.hpp>
+#include <sensor_msgs/msg/point_cloud2.hpp>
+#include <sensor_msgs/point_cloud2_iterator.hpp>
+#include <simple_sensor_simulator/sensor_simulation/lidar/raycaster.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/box.hpp>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
+#include <utility>
+#include <vector>
+
+namespace
+{
+auto makePose(double x, double y) -> geometry_msgs::msg::Pose
+{
+  geometry_msgs::msg::Pose pose;
+  pose.position.x = x;
+  pose.position.y = y;
+  pose.orientation.w = 1;
+  return pose;
+}
+
+auto makeRaycaster(simple_sensor_simulator::WorkerPool & worker_pool)
+  -> std::unique_ptr<simple_sensor_simulator::Raycaster>
+{
+  auto raycaster = std::make_unique<simple_sensor_simulator::Raycaster>(worker_pool);
+  simulation_api_schema::LidarConfiguration configuration;
+  configuration.set_horizontal_resolution(M_PI / 180);
+  configuration.add_vertical_angles(0);
+  raycaster->setDirection(configuration);
+  return raycaster;
+}
+
+auto raycast(simple_sensor_simulator::Raycaster & raycaster)
+  -> std::pair<std::vector<std::size_t>, sensor_msgs::msg::PointCloud2>
+{
+  sensor_msgs::msg::PointCloud2 pointcloud;
+  raycaster.raycast("base_link", rclcpp::Time(0), makePose(0, 0), pointcloud);
+  auto detected_objects = raycaster.getDetectedObject();
+  std::sort(std::begin(detected_objects), std::end(detected_objects));
+  return {detected_objects, pointcloud};
+}
+
+auto countPointsNear(const sensor_msgs::msg::PointCloud2 & pointcloud, double x, double y)
+  -> std::size_t
+{
+  std::size_t count = 0;
+  sensor_msgs::PointCloud2ConstIterator<float> iter_x(pointcloud, "x"), iter_y(pointcloud, "y");
+  for (; iter_x != iter_x.end(); ++iter_x, ++iter_y) {
+    count += std::hypot(*iter_x - x, *iter_y - y) < 1.5;
+  }
+  return count;
+}
+}  // namespace
+
+/*
+   The static primitives are instanced into the scene as geometry 0, so the
+   geometries of the entities start from 1 and must still be mapped back to
+   the ids they were added with.
+*/
+TEST(Raycaster, detectedObjectsWithStaticPrimitive)
+{
+  using simple_sensor_simulator::primitives::Box;
+
+  simple_sensor_simulator::WorkerPool worker_pool(4);
+
+  auto raycaster = makeRaycaster(worker_pool);
+  raycaster->addStaticPrimitive(Box(2, 2, 2, makePose(10, 0)));
+
+  raycaster->addPrimitive<Box>(42, 1, 1, 1, makePose(-5, 0));
+  raycaster->addPrimitive<Box>(7, 1, 1, 1, makePose(0, 5));
+  raycaster->addPrimitive<Box>(5, 1, 1, 1, makePose(15, 0));  // NOTE: behind the static box
+  {
+    const auto [detected_objects, pointcloud] = raycast(*raycaster);
+    EXPECT_EQ(detected_objects, (std::vector<std::size_t>{7, 42}));
+    EXPECT_LT(0u, countPointsNear(pointcloud, 9, 0));
+    EXPECT_LT(0u, countPointsNear(pointcloud, -4.5, 0));
+    EXPECT_LT(0u, countPointsNear(pointcloud, 0, 4.5));
+    EXPECT_EQ(0u, countPointsNear(pointcloud, 14.5, 0));
+  }
+
+  /*
+     The geometry ids of the previous raycast are reused by Embree.
+  */
+  raycaster->addPrimitive<Box>(3, 1, 1, 1, makePose(0, -5));
+  {
+    const auto [detected_objects, pointcloud] = raycast(*raycaster);
+    EXPECT_EQ(detected_objects, (std::vector<std::size_t>{3}));
+    EXPECT_LT(0u, countPointsNear(pointcloud, 9, 0));
+    EXPECT_EQ(0u, countPointsNear(pointcloud, -4.5, 0));
+  }
+
+  {
+    const auto [detected_objects, pointcloud] = raycast(*raycaster);
+    EXPECT_TRUE(detected_objects.empty());
+    EXPECT_LT(0u, countPointsNear(pointcloud, 9, 0));
+  }
+}
+
+TEST(Raycaster, detectedObjectsWithoutStaticPrimitive)
+{
+  using simple_sensor_simulator::primitives::Box;
+
+  simple_sensor_simulator::WorkerPool worker_pool(4);
+
+  auto raycaster = makeRaycaster(worker_pool);
+  raycaster->addPrimitive<Box>(42, 1, 1, 1, makePose(-5, 0));
+  raycaster->addPrimitive<Box>(0, 1, 1, 1, makePose(0, 5));
+
+  const auto [detected_objects, pointcloud] = raycast(*raycaster);
+  EXPECT_EQ(detected_objects, (std::vector<std::size_t>{0, 42}));
+  EXPECT_LT(0u, countPointsNear(pointcloud, -4.5, 0));
+  EXPECT_EQ(0u, countPointsNear(pointcloud, 9, 0));
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
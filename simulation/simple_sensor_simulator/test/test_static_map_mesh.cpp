@@ -0,0 +1,168 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+#include <lanelet2_core/LaneletMap.h>
+#include <lanelet2_core/utility/Utilities.h>
+
+#include <cmath>
+#include <cstddef>
+#include <simple_sensor_simulator/sensor_simulation/lidar/static_map_mesh.hpp>
+#include <simple_sensor_simulator/sensor_simulation/primitives/mesh.hpp>
+#include <vector>
+
+namespace
+{
+auto makePoints() -> std::vector<lanelet::Point3d>
+{
+  return {
+    lanelet::Point3d(lanelet::utils::getId(), 0, 0, 0),
+    lanelet::Point3d(lanelet::utils::getId(), 10, 0, 0),
+    lanelet::Point3d(lanelet::utils::getId(), 10, 10, 0),
+    lanelet::Point3d(lanelet::utils::getId(), 0, 10, 0)};
+}
+
+auto countTriangles(const lanelet::LineStrings3d & outer_bound) -> std::size_t
+{
+  auto area = lanelet::Area(lanelet::utils::getId(), outer_bound);
+  area.setAttribute("height", 3.0);
+  const lanelet::LaneletMapConstPtr lanelet_map = lanelet::utils::createMap(lanelet::Areas{area});
+  return simple_sensor_simulator::makeStaticMapMesh(lanelet_map).getTriangles().size();
+}
+
+/*
+   Mesh of a lanelet whose left bound runs along y = 4 and right bound along
+   y = 0, through the given x coordinates.
+*/
+auto makeLaneletMesh(const std::vector<double> & left_xs, const std::vector<double> & right_xs)
+  -> simple_sensor_simulator::primitives::Mesh
+{
+  auto make_bound = [](const std::vector<double> & xs, double y) {
+    lanelet::Points3d points;
+    for (const auto x : xs) {
+      points.emplace_back(lanelet::utils::getId(), x, y, 0);
+    }
+    return lanelet::LineString3d(lanelet::utils::getId(), points);
+  };
+  const lanelet::LaneletMapConstPtr lanelet_map = lanelet::utils::createMap(lanelet::Lanelets{
+    lanelet::Lanelet(lanelet::utils::getId(), make_bound(left_xs, 4), make_bound(right_xs, 0))});
+  return simple_sensor_simulator::makeStaticMapMesh(lanelet_map);
+}
+
+/*
+   Sum of the areas of the triangles, each of which must not be degenerate.
+*/
+auto area(const simple_sensor_simulator::primitives::Mesh & mesh) -> double
+{
+  const auto vertices = mesh.getVertex();
+  double sum = 0;
+  for (const auto & triangle : mesh.getTriangles()) {
+    const auto & p = vertices.at(triangle.v0);
+    const auto & q = vertices.at(triangle.v1);
+    const auto & r = vertices.at(triangle.v2);
+    const auto area = std::abs((q.x - p.x) * (r.y - p.y) - (r.x - p.x) * (q.y - p.y)) / 2;
+    EXPECT_LT(0, area);
+    sum += area;
+  }
+  return sum;
+}
+}  // namespace
+
+/*
+   A strip between bounds of l and r points is made of l + r - 2 triangles,
+   which cover the lanelet without overlapping.
+*/
+TEST(StaticMapMesh, laneletWithBoundsOfEqualLength)
+{
+  const auto mesh = makeLaneletMesh({0, 5, 10}, {0, 5, 10});
+  EXPECT_EQ(mesh.getTriangles().size(), 3u + 3u - 2u);
+  EXPECT_NEAR(area(mesh), 40, 1e-3);
+}
+
+TEST(StaticMapMesh, laneletWithBoundsOfUnequalLength)
+{
+  {
+    const auto mesh = makeLaneletMesh({0, 10}, {0, 2.5, 5, 7.5, 10});
+    EXPECT_EQ(mesh.getTriangles().size(), 2u + 5u - 2u);
+    EXPECT_NEAR(area(mesh), 40, 1e-3);
+  }
+  {
+    const auto mesh = makeLaneletMesh({0, 1, 2, 3, 4, 5, 6, 7, 8, 9, 10}, {0, 5, 10});
+    EXPECT_EQ(mesh.getTriangles().size(), 11u + 3u - 2u);
+    EXPECT_NEAR(area(mesh), 40, 1e-3);
+  }
+}
+
+/*
+   A bound of a single point makes a fan of triangles to the other bound, and
+   two of them make no triangle at all.
+*/
+TEST(StaticMapMesh, laneletWithSinglePointBound)
+{
+  {
+    const auto mesh = makeLaneletMesh({5}, {0, 5, 10});
+    EXPECT_EQ(mesh.getTriangles().size(), 1u + 3u - 2u);
+    EXPECT_NEAR(area(mesh), 20, 1e-3);
+  }
+  {
+    const auto mesh = makeLaneletMesh({0, 5, 10}, {5});
+    EXPECT_EQ(mesh.getTriangles().size(), 3u + 1u - 2u);
+    EXPECT_NEAR(area(mesh), 20, 1e-3);
+  }
+  EXPECT_TRUE(makeLaneletMesh({5}, {5}).getTriangles().empty());
+}
+
+/*
+   Each of the 4 walls of a square area is made of 2 triangles, however its
+   outer bound is split into linestrings.
+*/
+TEST(StaticMapMesh, areaWithSingleLineString)
+{
+  const auto p = makePoints();
+  EXPECT_EQ(countTriangles({lanelet::LineString3d(lanelet::utils::getId(), p)}), 8u);
+}
+
+TEST(StaticMapMesh, areaWithClosedLineString)
+{
+  const auto p = makePoints();
+  EXPECT_EQ(
+    countTriangles(
+      {lanelet::LineString3d(lanelet::utils::getId(), {p[0], p[1], p[2], p[3], p[0]})}),
+    8u);
+}
+
+TEST(StaticMapMesh, areaWithSeveralLineStrings)
+{
+  const auto p = makePoints();
+  EXPECT_EQ(
+    countTriangles(
+      {lanelet::LineString3d(lanelet::utils::getId(), {p[0], p[1], p[2]}),
+       lanelet::LineString3d(lanelet::utils::getId(), {p[2], p[3], p[0]})}),
+    8u);
+}
+
+TEST(StaticMapMesh, areaWithoutHeight)
+{
+  const auto p = makePoints();
+  auto area = lanelet::Area(
+    lanelet::utils::getId(), {lanelet::LineString3d(lanelet::utils::getId(), p)});
+  const lanelet::LaneletMapConstPtr lanelet_map = lanelet::utils::createMap(lanelet::Areas{area});
+  EXPECT_TRUE(simple_sensor_simulator::makeStaticMapMesh(lanelet_map).getTriangles().empty());
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
@@ -0,0 +1,102 @@
+// Copyright 2015 TIER IV, Inc. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License");
+// you may not use this file except in compliance with the License.
+// You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <cstddef>
+#include <simple_sensor_simulator/sensor_simulation/worker_pool.hpp>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+TEST(WorkerPool, everyTaskRunsOnce)
+{
+  for (const std::size_t size : {1, 2, 4}) {
+    simple_sensor_simulator::WorkerPool worker_pool(size);
+    EXPECT_EQ(worker_pool.size(), size);
+    for (const std::size_t count : {0, 1, 3, 1000}) {
+      std::vector<std::atomic<int>> calls(count);
+      worker_pool.run(count, [&](std::size_t i) { ++calls[i]; });
+      for (const auto & call : calls) {
+        EXPECT_EQ(call, 1);
+      }
+    }
+  }
+}
+
+/*
+   A task may wait for tasks of its own, as a lidar raycasting on the pool
+   does while the sensors are updated on the pool.
+*/
+TEST(WorkerPool, nestedRuns)
+{
+  simple_sensor_simulator::WorkerPool worker_pool(3);
+
+  std::atomic<std::size_t> count = 0;
+
+  worker_pool.run(8, [&](std::size_t) {
+    worker_pool.run(4, [&](std::size_t) { worker_pool.run(25, [&](std::size_t) { ++count; }); });
+  });
+
+  EXPECT_EQ(count, 8u * 4u * 25u);
+}
+
+TEST(WorkerPool, concurrentCallers)
+{
+  simple_sensor_simulator::WorkerPool worker_pool(4);
+
+  std::atomic<std::size_t> count = 0;
+
+  std::vector<std::thread> callers;
+  for (auto i = 0; i < 4; ++i) {
+    callers.emplace_back([&]() {
+      for (auto j = 0; j < 100; ++j) {
+        worker_pool.run(10, [&](std::size_t) { ++count; });
+      }
+    });
+  }
+  for (auto && caller : callers) {
+    caller.join();
+  }
+
+  EXPECT_EQ(count, 4u * 100u * 10u);
+}
+
+TEST(WorkerPool, exceptionIsRethrownAfterEveryTask)
+{
+  simple_sensor_simulator::WorkerPool worker_pool(4);
+
+  std::atomic<std::size_t> count = 0;
+
+  EXPECT_THROW(
+    worker_pool.run(
+      100,
+      [&](std::size_t i) {
+        if (i % 10 == 3) {
+          throw std::runtime_error("task failed");
+        } else {
+          ++count;
+        }
+      }),
+    std::runtime_error);
+
+  EXPECT_EQ(count, 90u);
+}
+
+int main(int argc, char ** argv)
+{
+  testing::InitGoogleTest(&argc, argv);
+  return RUN_ALL_TESTS();
+}
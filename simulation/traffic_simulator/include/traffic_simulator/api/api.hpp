@@ -118,6 +118,11 @@ public:
 
   void closeZMQConnection() { zeromq_client_.closeConnection(); }
 
+  auto getHdmapUtils() const -> const std::shared_ptr<hdmap_utils::HdMapUtils> &
+  {
+    return entity_manager_ptr_->getHdmapUtils();
+  }
+
   void setVerbose(const bool verbose);
 
   template <typename Pose>
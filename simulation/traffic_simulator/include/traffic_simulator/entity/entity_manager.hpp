@@ -170,8 +170,8 @@ public:
     lanelet_marker_pub_ptr_(rclcpp::create_publisher<MarkerArray>(
       node, "lanelet/marker", LaneletMarkerQoS(),
       rclcpp::PublisherOptionsWithAllocator<AllocatorT>())),
-    hdmap_utils_ptr_(std::make_shared<hdmap_utils::HdMapUtils>(
-      configuration.lanelet2_map_path(), getOrigin(*node))),
+    hdmap_utils_ptr_(
+      hdmap_utils::HdMapUtils::load(configuration.lanelet2_map_path(), getOrigin(*node))),
     markers_raw_(hdmap_utils_ptr_->generateMarker()),
     conventional_traffic_light_manager_ptr_(
       std::make_shared<TrafficLightManager>(hdmap_utils_ptr_)),
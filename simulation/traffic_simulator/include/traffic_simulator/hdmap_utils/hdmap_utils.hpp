@@ -63,6 +63,15 @@ class HdMapUtils
 public:
   explicit HdMapUtils(const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &);
 
+  /*
+     Returns the instance for the given map and origin that is currently alive
+     in this process (e.g. held by another traffic_simulator::API), or loads a
+     new one. HdMapUtils is immutable except for its internally synchronized
+     caches, so the instance can be shared between threads.
+  */
+  static auto load(const boost::filesystem::path &, const geographic_msgs::msg::GeoPoint &)
+    -> std::shared_ptr<HdMapUtils>;
+
   auto canChangeLane(const lanelet::Id from, const lanelet::Id to) const -> bool;
 
   auto canonicalizeLaneletPose(const traffic_simulator_msgs::msg::LaneletPose &) const
@@ -166,6 +175,8 @@ public:
 
   auto getLaneletLength(const lanelet::Id) const -> double;
 
+  auto getLaneletMap() const -> lanelet::LaneletMapConstPtr;
+
   auto getLaneletPolygon(const lanelet::Id) const -> std::vector<geometry_msgs::msg::Point>;
 
   auto getLateralDistance(
@@ -255,6 +266,8 @@ public:
   auto getTrafficLightStopLinesPoints(const lanelet::Id traffic_light_id) const
     -> std::vector<std::vector<geometry_msgs::msg::Point>>;
 
+  auto getVehicleRoutingGraph() const -> lanelet::routing::RoutingGraphConstPtr;
+
   auto insertMarkerArray(
     visualization_msgs::msg::MarkerArray &, const visualization_msgs::msg::MarkerArray &) const
     -> void;
@@ -37,7 +37,9 @@
 #include <lanelet2_extension/utility/query.hpp>
 #include <lanelet2_extension/utility/utilities.hpp>
 #include <lanelet2_extension/visualization/visualization.hpp>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
 #include <scenario_simulator_exception/exception.hpp>
 #include <set>
@@ -45,6 +47,7 @@
 #include <traffic_simulator/color_utils/color_utils.hpp>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 #include <traffic_simulator/helper/helper.hpp>
+#include <tuple>
 #include <unordered_map>
 #include <utility>
 #include <vector>
@@ -85,6 +88,38 @@ HdMapUtils::HdMapUtils(
     lanelet::utils::query::shoulderLanelets(lanelet::utils::query::laneletLayer(lanelet_map_ptr_));
 }
 
+auto HdMapUtils::load(
+  const boost::filesystem::path & lanelet2_map_path, const geographic_msgs::msg::GeoPoint & origin)
+  -> std::shared_ptr<HdMapUtils>
+{
+  static std::mutex mutex;
+
+  static std::map<std::tuple<std::string, double, double>, std::weak_ptr<HdMapUtils>> instances;
+
+  /*
+     NOTE: The lock is held while loading, so that concurrent callers
+     requesting the same map wait for the first one instead of loading it
+     again.
+  */
+  std::lock_guard<std::mutex> lock(mutex);
+
+  for (auto iter = std::begin(instances); iter != std::end(instances);) {
+    iter = iter->second.expired() ? instances.erase(iter) : std::next(iter);
+  }
+
+  auto & instance = instances[std::make_tuple(
+    boost::filesystem::absolute(lanelet2_map_path).lexically_normal().string(), origin.latitude,
+    origin.longitude)];
+
+  if (auto loaded = instance.lock()) {
+    return loaded;
+  } else {
+    loaded = std::make_shared<HdMapUtils>(lanelet2_map_path, origin);
+    instance = loaded;
+    return loaded;
+  }
+}
+
 auto HdMapUtils::getAllCanonicalizedLaneletPoses(
   const traffic_simulator_msgs::msg::LaneletPose & lanelet_pose) const
   -> std::vector<traffic_simulator_msgs::msg::LaneletPose>
@@ -938,6 +973,13 @@ auto HdMapUtils::getLaneletLength(const lanelet::Id lanelet_id) const -> double
   return ret;
 }
 
+auto HdMapUtils::getLaneletMap() const -> lanelet::LaneletMapConstPtr { return lanelet_map_ptr_; }
+
+auto HdMapUtils::getVehicleRoutingGraph() const -> lanelet::routing::RoutingGraphConstPtr
+{
+  return vehicle_routing_graph_ptr_;
+}
+
 auto HdMapUtils::getPreviousRoadShoulderLanelet(const lanelet::Id lanelet_id) const -> lanelet::Ids
 {
   lanelet::Ids ids;
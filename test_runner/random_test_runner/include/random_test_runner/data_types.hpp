@@ -61,6 +61,8 @@ struct TestControlParameters
   ArchitectureType architecture_type = ArchitectureType::AWF_UNIVERSE;
   std::string simulator_host = "localhost";
   double test_timeout = 60.0;
+  int64_t parallel_test_count = 1;
+  bool as_fast_as_possible = false;
 };
 
 struct TestSuiteParameters
@@ -131,8 +133,10 @@ DEFINE_FMT_FORMATTER(
 
 DEFINE_FMT_FORMATTER(
   TestControlParameters,
-  "input dir: {} output dir: {} random test type: {} test count {} test_timeout {}", v.input_dir,
-  v.output_dir, v.random_test_type, v.test_count, v.test_timeout)
+  "input dir: {} output dir: {} random test type: {} test count {} test_timeout {} "
+  "parallel_test_count {} as_fast_as_possible {}",
+  v.input_dir, v.output_dir, v.random_test_type, v.test_count, v.test_timeout,
+  v.parallel_test_count, v.as_fast_as_possible)
 
 DEFINE_FMT_FORMATTER(
   TestSuiteParameters,
@@ -21,6 +21,8 @@
 #include <lanelet2_routing/RoutingGraph.h>
 
 #include <boost/filesystem.hpp>
+#include <geographic_msgs/msg/geo_point.hpp>
+#include <memory>
 #include <optional>
 
 #include "geometry_msgs/msg/pose_stamped.hpp"
@@ -41,7 +43,14 @@ struct LaneletPart
 class LaneletUtils
 {
 public:
-  LaneletUtils(const boost::filesystem::path & filename);
+  /*
+     The map is obtained through hdmap_utils::HdMapUtils::load, so it is
+     shared with every traffic_simulator::API of this process that uses the
+     same map and origin, instead of being loaded once more.
+  */
+  explicit LaneletUtils(
+    const boost::filesystem::path & filename,
+    const geographic_msgs::msg::GeoPoint & origin = geographic_msgs::msg::GeoPoint());
 
   LaneletUtils() = delete;
   LaneletUtils(const LaneletUtils &) = delete;
@@ -66,9 +75,9 @@ public:
   bool isInLanelet(int64_t lanelet_id, double s);
 
 private:
-  lanelet::LaneletMapPtr lanelet_map_ptr_;
-  lanelet::routing::RoutingGraphConstPtr vehicle_routing_graph_ptr_;
   std::shared_ptr<hdmap_utils::HdMapUtils> hdmap_utils_ptr_;
+  lanelet::LaneletMapConstPtr lanelet_map_ptr_;
+  lanelet::routing::RoutingGraphConstPtr vehicle_routing_graph_ptr_;
 };
 
 #endif  // RANDOM_TEST_RUNNER__LANELET_UTILS_HPP
@@ -17,9 +17,15 @@
 #ifndef RANDOM_TEST_RUNNER__RANDOM_TEST_RUNNER_HPP
 #define RANDOM_TEST_RUNNER__RANDOM_TEST_RUNNER_HPP
 
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <memory>
+#include <optional>
 #include <random>
 #include <rclcpp/rclcpp.hpp>
+#include <thread>
+#include <vector>
 
 #include "random_test_runner/data_types.hpp"
 #include "random_test_runner/file_interactions/junit_xml_reporter.hpp"
@@ -36,6 +42,8 @@ class RandomTestRunner : public rclcpp::Node
 public:
   explicit RandomTestRunner(const rclcpp::NodeOptions & option);
 
+  ~RandomTestRunner() override;
+
 private:
   TestControlParameters collectAndValidateTestControlParameters();
   TestSuiteParameters collectTestSuiteParameters();
@@ -44,19 +52,47 @@ private:
   static TestSuiteParameters validateParameters(
     const TestSuiteParameters & test_parameters, std::shared_ptr<LaneletUtils> hdmap_utils);
 
+  rclcpp::Node::SharedPtr createWorkerNode(std::size_t worker_id, int64_t port);
+
+  void runWorker(std::size_t worker_id);
+
   void update();
   void start();
   void stop();
 
   std::random_device seed_randomization_device_;
 
-  std::vector<TestExecutor<traffic_simulator::API>> test_executors_;
-  std::vector<TestExecutor<traffic_simulator::API>>::iterator current_test_executor_;
+  std::shared_ptr<LaneletUtils> lanelet_utils_;
 
-  JunitXmlReporter error_reporter_;
+  std::vector<TestDescription> test_descriptions_;
+  std::vector<JunitXmlReporterTestCase> test_case_reporters_;
+
+  /*
+     Test executors (and their traffic_simulator::API) are created right
+     before their test starts and destroyed right after it ends, so only the
+     currently running tests hold simulator resources.
+  */
+  std::function<TestExecutor<traffic_simulator::API>(size_t test_id, rclcpp::Node * node)>
+    make_test_executor_;
 
-  std::shared_ptr<traffic_simulator::API> api_;
+  std::optional<TestExecutor<traffic_simulator::API>> current_test_executor_;
+  size_t current_test_id_ = 0;
+
+  JunitXmlReporter error_reporter_;
 
   rclcpp::TimerBase::SharedPtr update_timer_;
+
+  /*
+     Used only if parallel_test_count > 1. Worker k owns the k-th node (and
+     therefore the k-th sensor simulator port) and, on its own thread, runs
+     the next test not yet taken by another worker until none is left.
+  */
+  std::vector<rclcpp::Node::SharedPtr> worker_nodes_;
+
+  std::atomic<size_t> next_test_id_{0};
+
+  std::thread parallel_runner_;
+
+  std::chrono::milliseconds update_period_{50};
 };
 #endif  // RANDOM_TEST_RUNNER__RANDOM_TEST_RUNNER_HPP
@@ -64,6 +64,14 @@ class RandomTestRunnerLaunch(object):
             # control arguments #
             "test_count": {"default": 5, "description": "Test count to be performed in test suite"},
             "test_timeout": {"default": 60.0, "description": "Timeout of the single test"},
+            "as_fast_as_possible":
+                {"default": False,
+                 "description": "If true, the next frame starts as soon as the previous one is completed instead of "
+                                "every 50 ms. Intended for runs without Autoware"},
+            "parallel_test_count":
+                {"default": 1,
+                 "description": "Number of tests run concurrently. Test runner worker i connects to the "
+                                "simulator on port (port + i)"},
             "input_dir":
                 {"default": "",
                  "description": "Directory containing the result.yaml file to be replayed. "
@@ -201,22 +209,29 @@ class RandomTestRunnerLaunch(object):
                 name="visualizer",
                 output="screen",
             ),
-            Node(
+        ]
+
+        port = int(self.random_test_runner_launch_configuration["port"].perform(context))
+        parallel_test_count = int(
+            self.random_test_runner_launch_configuration["parallel_test_count"].perform(context))
+
+        # one simulator per test runner worker, listening on consecutive ports
+        for worker_id in range(parallel_test_count):
+            launch_description.append(Node(
                 package="simple_sensor_simulator",
                 executable="simple_sensor_simulator_node",
-                name="simple_sensor_simulator_node",
+                name="simple_sensor_simulator_node" + ("_{}".format(worker_id) if worker_id else ""),
                 namespace="simulation",
                 output="log",
                 arguments=[("__log_level:=warn")],
-                parameters=[{"port": 8080}],
+                parameters=[{"port": port + worker_id}],
                 condition=IfCondition(
                     PythonExpression([
                         "'", self.random_test_runner_launch_configuration["simulator_type"], "'",
                         ' == "simple_sensor_simulator"'
                     ])
                 ),
-            )
-        ]
+            ))
 
         return launch_description
 
@@ -17,33 +17,17 @@
 #include "random_test_runner/lanelet_utils.hpp"
 
 #include <lanelet2_core/geometry/Lanelet.h>
-#include <lanelet2_io/Io.h>
-#include <lanelet2_routing/RoutingCost.h>
-#include <lanelet2_traffic_rules/TrafficRulesFactory.h>
 
-#include <geographic_msgs/msg/geo_point.hpp>
 #include <geometry/linear_algebra.hpp>
-#include <lanelet2_extension/projection/mgrs_projector.hpp>
 #include <optional>
 #include <traffic_simulator/hdmap_utils/hdmap_utils.hpp>
 
-LaneletUtils::LaneletUtils(const boost::filesystem::path & filename)
+LaneletUtils::LaneletUtils(
+  const boost::filesystem::path & filename, const geographic_msgs::msg::GeoPoint & origin)
+: hdmap_utils_ptr_(hdmap_utils::HdMapUtils::load(filename, origin)),
+  lanelet_map_ptr_(hdmap_utils_ptr_->getLaneletMap()),
+  vehicle_routing_graph_ptr_(hdmap_utils_ptr_->getVehicleRoutingGraph())
 {
-  lanelet::projection::MGRSProjector projector;
-  lanelet::ErrorMessages errors;
-  lanelet_map_ptr_ = lanelet::load(filename.string(), projector, &errors);
-
-  double arbitraryLaneChangeCostUsedOnlyForRouteFeasibilityTest = 2;
-  lanelet::routing::RoutingCostPtrs costPtrs{
-    std::make_shared<lanelet::routing::RoutingCostDistance>(
-      arbitraryLaneChangeCostUsedOnlyForRouteFeasibilityTest)};
-  auto traffic_rules_vehicle_ptr = lanelet::traffic_rules::TrafficRulesFactory::create(
-    lanelet::Locations::Germany, lanelet::Participants::Vehicle);
-  vehicle_routing_graph_ptr_ =
-    lanelet::routing::RoutingGraph::build(*lanelet_map_ptr_, *traffic_rules_vehicle_ptr, costPtrs);
-
-  hdmap_utils_ptr_ =
-    std::make_shared<hdmap_utils::HdMapUtils>(filename, geographic_msgs::msg::GeoPoint());
 }
 
 std::vector<int64_t> LaneletUtils::getLaneletIds() { return hdmap_utils_ptr_->getLaneletIds(); }
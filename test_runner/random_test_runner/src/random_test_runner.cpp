@@ -18,6 +18,8 @@
 
 #include <ament_index_cpp/get_package_share_directory.hpp>
 #include <boost/optional/optional_io.hpp>
+#include <chrono>
+#include <geographic_msgs/msg/geo_point.hpp>
 #include <memory>
 #include <random_test_runner/file_interactions/yaml_test_params_saver.hpp>
 #include <random_test_runner/lanelet_utils.hpp>
@@ -36,6 +38,15 @@ RandomTestRunner::RandomTestRunner(const rclcpp::NodeOptions & option)
   std::string message = fmt::format("test control parameters: {}", test_control_parameters);
   RCLCPP_INFO_STREAM(get_logger(), message);
 
+  /*
+     The simulation time is advanced by SimulationClock by a fixed step on
+     every updateFrame, regardless of the wall clock. So without Autoware in
+     the loop, the next frame can start as soon as the previous one is done.
+  */
+  if (test_control_parameters.as_fast_as_possible) {
+    update_period_ = std::chrono::milliseconds(0);
+  }
+
   TestSuiteParameters test_suite_params;
   std::vector<TestCaseParameters> test_case_parameters_vector;
   switch (test_control_parameters.random_test_type) {
@@ -65,9 +76,19 @@ RandomTestRunner::RandomTestRunner(const rclcpp::NodeOptions & option)
 
   traffic_simulator::Configuration configuration(map_path);
   configuration.simulator_host = test_control_parameters.simulator_host;
-  auto lanelet_utils = std::make_shared<LaneletUtils>(configuration.lanelet2_map_path());
 
-  TestSuiteParameters validated_params = validateParameters(test_suite_params, lanelet_utils);
+  geographic_msgs::msg::GeoPoint origin;
+  origin.latitude = this->declare_parameter<double>("origin_latitude", 0.0);
+  origin.longitude = this->declare_parameter<double>("origin_longitude", 0.0);
+
+  /*
+     LaneletUtils is kept alive until the end of the test suite, so every
+     traffic_simulator::API (created for one test and destroyed after it) gets
+     the map loaded here from hdmap_utils::HdMapUtils::load.
+  */
+  lanelet_utils_ = std::make_shared<LaneletUtils>(configuration.lanelet2_map_path(), origin);
+
+  TestSuiteParameters validated_params = validateParameters(test_suite_params, lanelet_utils_);
 
   message = fmt::format("Test suite parameters {}", test_suite_params);
   RCLCPP_INFO_STREAM(get_logger(), message);
@@ -83,27 +104,48 @@ RandomTestRunner::RandomTestRunner(const rclcpp::NodeOptions & option)
 
   yaml_test_params_saver.addTestSuite(validated_params, validated_params.name);
 
+  if (test_control_parameters.parallel_test_count > 1) {
+    const auto port = this->declare_parameter<int64_t>("port", 5555);
+    for (int64_t worker_id = 0; worker_id < test_control_parameters.parallel_test_count;
+         worker_id++) {
+      worker_nodes_.push_back(createWorkerNode(worker_id, port + worker_id));
+    }
+  }
+
   for (size_t test_id = 0; test_id < test_case_parameters_vector.size(); test_id++) {
     std::string message =
       fmt::format("Generating test {}/{}", test_id + 1, test_case_parameters_vector.size());
     RCLCPP_INFO_STREAM(get_logger(), message);
-    test_executors_.emplace_back(
-      std::make_shared<traffic_simulator::API>(this, configuration, 1.0, 20),
+    test_descriptions_.emplace_back(
       TestRandomizer(
-        get_logger(), validated_params, test_case_parameters_vector[test_id], lanelet_utils)
-        .generate(),
-      error_reporter_.spawnTestCase(validated_params.name, std::to_string(test_id)),
-      test_control_parameters.test_timeout, test_control_parameters.architecture_type,
-      get_logger());
+        get_logger(), validated_params, test_case_parameters_vector[test_id], lanelet_utils_)
+        .generate());
+    test_case_reporters_.emplace_back(
+      error_reporter_.spawnTestCase(validated_params.name, std::to_string(test_id)));
     yaml_test_params_saver.addTestCase(test_case_parameters_vector[test_id], validated_params.name);
   }
 
-  current_test_executor_ = test_executors_.begin();
+  make_test_executor_ = [this, configuration, test_control_parameters](
+                          size_t test_id, rclcpp::Node * node) {
+    return TestExecutor<traffic_simulator::API>(
+      std::make_shared<traffic_simulator::API>(node, configuration, 1.0, 20),
+      test_descriptions_[test_id], test_case_reporters_[test_id],
+      test_control_parameters.test_timeout, test_control_parameters.architecture_type,
+      get_logger());
+  };
+
   yaml_test_params_saver.write();
 
   start();
 }
 
+RandomTestRunner::~RandomTestRunner()
+{
+  if (parallel_runner_.joinable()) {
+    parallel_runner_.join();
+  }
+}
+
 TestSuiteParameters RandomTestRunner::collectTestSuiteParameters()
 {
   TestSuiteParameters tp;
@@ -157,6 +199,12 @@ TestControlParameters RandomTestRunner::collectAndValidateTestControlParameters(
     throw std::runtime_error(
       fmt::format("Test timeout cannot be 0.0 or negative. Currently is {}", tp.test_timeout));
   }
+  tp.as_fast_as_possible = this->declare_parameter<bool>("as_fast_as_possible", false);
+  tp.parallel_test_count = this->declare_parameter<int64_t>("parallel_test_count", 1);
+  if (tp.parallel_test_count < 1) {
+    throw std::runtime_error(fmt::format(
+      "Parallel test count cannot be less than 1. Currently is {}", tp.parallel_test_count));
+  }
 
   return tp;
 }
@@ -186,19 +234,70 @@ TestSuiteParameters RandomTestRunner::validateParameters(
   return tp;
 }
 
+rclcpp::Node::SharedPtr RandomTestRunner::createWorkerNode(std::size_t worker_id, int64_t port)
+{
+  /*
+     Global arguments (e.g. the node name remapping passed by the launch file)
+     must not be applied, otherwise every worker node would be renamed to this
+     node. Instead, every parameter override this node was given is passed to
+     the worker explicitly, except for the port that differs per worker.
+  */
+  std::vector<rclcpp::Parameter> parameter_overrides;
+  for (const auto & [name, value] : get_node_parameters_interface()->get_parameter_overrides()) {
+    if (name != "port" and name != "use_sim_time") {
+      parameter_overrides.emplace_back(name, value);
+    }
+  }
+  parameter_overrides.emplace_back("port", port);
+  parameter_overrides.push_back(get_parameter("use_sim_time"));
+
+  std::string message =
+    fmt::format("Worker {} connects to the sensor simulator on port {}", worker_id, port);
+  RCLCPP_INFO_STREAM(get_logger(), message);
+
+  const auto node_namespace = std::string(get_namespace());
+  return std::make_shared<rclcpp::Node>(
+    fmt::format("worker_{}", worker_id),
+    (node_namespace == "/" ? "" : node_namespace) + "/random_test_runner",
+    rclcpp::NodeOptions().use_global_arguments(false).parameter_overrides(parameter_overrides));
+}
+
+void RandomTestRunner::runWorker(std::size_t worker_id)
+{
+  rclcpp::executors::SingleThreadedExecutor executor;
+  executor.add_node(worker_nodes_[worker_id]);
+
+  for (auto test_id = next_test_id_++; test_id < test_descriptions_.size() && rclcpp::ok();
+       test_id = next_test_id_++) {
+    std::string message = fmt::format(
+      "Worker {}: running test {}/{}", worker_id, test_id + 1, test_descriptions_.size());
+    RCLCPP_INFO_STREAM(get_logger(), message);
+
+    auto test_executor = make_test_executor_(test_id, worker_nodes_[worker_id].get());
+    test_executor.initialize();
+    for (auto next_update = std::chrono::steady_clock::now();
+         !test_executor.scenarioCompleted() && rclcpp::ok();) {
+      executor.spin_some();
+      test_executor.update();
+      std::this_thread::sleep_until(next_update += update_period_);
+    }
+    test_executor.deinitialize();
+  }
+}
+
 void RandomTestRunner::update()
 {
   if (current_test_executor_->scenarioCompleted()) {
     current_test_executor_->deinitialize();
-    current_test_executor_++;
-    if (current_test_executor_ == test_executors_.end()) {
+    current_test_executor_.reset();
+    if (++current_test_id_ == test_descriptions_.size()) {
       stop();
       return;
     }
-    std::string message = fmt::format(
-      "Running test {}/{}", std::distance(test_executors_.begin(), current_test_executor_) + 1,
-      test_executors_.size());
+    std::string message =
+      fmt::format("Running test {}/{}", current_test_id_ + 1, test_descriptions_.size());
     RCLCPP_INFO_STREAM(get_logger(), message);
+    current_test_executor_.emplace(make_test_executor_(current_test_id_, this));
     current_test_executor_->initialize();
   }
 
@@ -207,18 +306,40 @@ void RandomTestRunner::update()
 
 void RandomTestRunner::start()
 {
-  std::string message = fmt::format(
-    "Running test {}/{}", std::distance(test_executors_.begin(), current_test_executor_) + 1,
-    test_executors_.size());
+  if (!worker_nodes_.empty()) {
+    /*
+       Every test case reports to its own JunitXmlReporterTestCase, spawned
+       before the workers start, so the workers never touch the same test case
+       and the results are merged into one result.junit.xml when all of them
+       have finished.
+    */
+    parallel_runner_ = std::thread([this]() {
+      std::vector<std::thread> workers;
+      for (size_t worker_id = 0; worker_id < worker_nodes_.size(); worker_id++) {
+        workers.emplace_back(&RandomTestRunner::runWorker, this, worker_id);
+      }
+      for (auto & worker : workers) {
+        worker.join();
+      }
+      stop();
+    });
+    return;
+  }
+
+  std::string message =
+    fmt::format("Running test {}/{}", current_test_id_ + 1, test_descriptions_.size());
   RCLCPP_INFO_STREAM(get_logger(), message);
+  current_test_executor_.emplace(make_test_executor_(current_test_id_, this));
   current_test_executor_->initialize();
-  update_timer_ = this->create_wall_timer(
-    std::chrono::milliseconds(50), std::bind(&RandomTestRunner::update, this));
+  update_timer_ =
+    this->create_wall_timer(update_period_, std::bind(&RandomTestRunner::update, this));
 }
 
 void RandomTestRunner::stop()
 {
   error_reporter_.write();
-  update_timer_->cancel();
+  if (update_timer_) {
+    update_timer_->cancel();
+  }
   rclcpp::shutdown();
 }
@@ -61,8 +61,10 @@ def default_autoware_launch_file_of(architecture_type):
 def launch_setup(context, *args, **kwargs):
     # fmt: off
     architecture_type                   = LaunchConfiguration("architecture_type",                      default="awf/universe")
+    as_fast_as_possible                 = LaunchConfiguration("as_fast_as_possible",                    default=False)
     autoware_launch_file                = LaunchConfiguration("autoware_launch_file",                   default=default_autoware_launch_file_of(architecture_type.perform(context)))
     autoware_launch_package             = LaunchConfiguration("autoware_launch_package",                default=default_autoware_launch_package_of(architecture_type.perform(context)))
+    batch_mode                          = LaunchConfiguration("batch_mode",                             default=False)
     consider_acceleration_by_road_slope = LaunchConfiguration("consider_acceleration_by_road_slope",    default=False)
     consider_pose_by_road_slope         = LaunchConfiguration("consider_pose_by_road_slope",            default=True)
     global_frame_rate                   = LaunchConfiguration("global_frame_rate",                      default=30.0)
@@ -72,6 +74,7 @@ def launch_setup(context, *args, **kwargs):
     launch_autoware                     = LaunchConfiguration("launch_autoware",                        default=True)
     launch_rviz                         = LaunchConfiguration("launch_rviz",                            default=False)
     launch_simple_sensor_simulator      = LaunchConfiguration("launch_simple_sensor_simulator",         default=True)
+    lidar_static_map                    = LaunchConfiguration("lidar_static_map",                       default=False)
     output_directory                    = LaunchConfiguration("output_directory",                       default=Path("/tmp"))
     port                                = LaunchConfiguration("port",                                   default=5555)
     record                              = LaunchConfiguration("record",                                 default=True)
@@ -84,8 +87,10 @@ def launch_setup(context, *args, **kwargs):
     # fmt: on
 
     print(f"architecture_type                   := {architecture_type.perform(context)}")
+    print(f"as_fast_as_possible                 := {as_fast_as_possible.perform(context)}")
     print(f"autoware_launch_file                := {autoware_launch_file.perform(context)}")
     print(f"autoware_launch_package             := {autoware_launch_package.perform(context)}")
+    print(f"batch_mode                          := {batch_mode.perform(context)}")
     print(f"consider_acceleration_by_road_slope := {consider_acceleration_by_road_slope.perform(context)}")
     print(f"consider_pose_by_road_slope         := {consider_pose_by_road_slope.perform(context)}")
     print(f"global_frame_rate                   := {global_frame_rate.perform(context)}")
@@ -94,6 +99,7 @@ def launch_setup(context, *args, **kwargs):
     print(f"initialize_duration                 := {initialize_duration.perform(context)}")
     print(f"launch_autoware                     := {launch_autoware.perform(context)}")
     print(f"launch_rviz                         := {launch_rviz.perform(context)}")
+    print(f"lidar_static_map                    := {lidar_static_map.perform(context)}")
     print(f"output_directory                    := {output_directory.perform(context)}")
     print(f"port                                := {port.perform(context)}")
     print(f"record                              := {record.perform(context)}")
@@ -107,12 +113,15 @@ def launch_setup(context, *args, **kwargs):
     def make_parameters():
         parameters = [
             {"architecture_type": architecture_type},
+            {"as_fast_as_possible": as_fast_as_possible},
             {"autoware_launch_file": autoware_launch_file},
             {"autoware_launch_package": autoware_launch_package},
+            {"batch_mode": batch_mode},
             {"consider_acceleration_by_road_slope": consider_acceleration_by_road_slope},
             {"consider_pose_by_road_slope": consider_pose_by_road_slope},
             {"initialize_duration": initialize_duration},
             {"launch_autoware": launch_autoware},
+            {"lidar_static_map": lidar_static_map},
             {"port": port},
             {"record": record},
             {"rviz_config": rviz_config},
@@ -139,8 +148,10 @@ def launch_setup(context, *args, **kwargs):
     return [
         # fmt: off
         DeclareLaunchArgument("architecture_type",                   default_value=architecture_type                  ),
+        DeclareLaunchArgument("as_fast_as_possible",                 default_value=as_fast_as_possible                ),
         DeclareLaunchArgument("autoware_launch_file",                default_value=autoware_launch_file               ),
         DeclareLaunchArgument("autoware_launch_package",             default_value=autoware_launch_package            ),
+        DeclareLaunchArgument("batch_mode",                          default_value=batch_mode                         ),
         DeclareLaunchArgument("consider_acceleration_by_road_slope", default_value=consider_acceleration_by_road_slope),
         DeclareLaunchArgument("consider_pose_by_road_slope",         default_value=consider_pose_by_road_slope        ),
         DeclareLaunchArgument("global_frame_rate",                   default_value=global_frame_rate                  ),
@@ -148,6 +159,7 @@ def launch_setup(context, *args, **kwargs):
         DeclareLaunchArgument("global_timeout",                      default_value=global_timeout                     ),
         DeclareLaunchArgument("launch_autoware",                     default_value=launch_autoware                    ),
         DeclareLaunchArgument("launch_rviz",                         default_value=launch_rviz                        ),
+        DeclareLaunchArgument("lidar_static_map",                    default_value=lidar_static_map                   ),
         DeclareLaunchArgument("output_directory",                    default_value=output_directory                   ),
         DeclareLaunchArgument("rviz_config",                         default_value=rviz_config                        ),
         DeclareLaunchArgument("scenario",                            default_value=scenario                           ),